@@ -27,61 +27,139 @@
 #ifndef DS_ARRAY_QUEUE_H
 #define DS_ARRAY_QUEUE_H
 
+#include <cstring>
 #include <stdexcept>
+#include <type_traits>
 
+/* Array implementation of Queue as a ring buffer.
+ * head and tail run freely and are masked into the array, which is rounded up to a
+ * power of two, so push and pop are O(1). At most MaxSize elements are held. */
 template<typename Type, size_t MaxSize = 32>
 class ArrayQueue
 {
   public:
-    ArrayQueue() : m_back(-1) {}
+    ArrayQueue() : m_head(0), m_tail(0) {}
     ArrayQueue(const ArrayQueue<Type, MaxSize>& queue);
+    ArrayQueue<Type, MaxSize>& operator=(const ArrayQueue<Type, MaxSize>& queue);
     ~ArrayQueue() { clear(); }
 
-    inline bool empty() const { return (m_back == -1); }
-    inline size_t size() const { return (m_back + 1); }
+    inline bool empty() const { return (m_head == m_tail); }
+    inline size_t size() const { return (m_tail - m_head); }
 
-    inline Type front() const { return m_data[0]; }
-    inline Type back() const { return m_data[m_back]; }
+    inline Type front() const { return m_data[m_head & mask]; }
+    inline Type back() const { return m_data[(m_tail - 1) & mask]; }
 
     void push(Type value);
     Type pop();
-    void clear() { m_back = -1; }
+    void clear() { m_head = m_tail = 0; }
+
+    // Push count values in order, copying at most two contiguous segments.
+    // Returns the number pushed.
+    size_t push_range(const Type* values, size_t count);
+
+    // Pop up to count values into out, copying at most two contiguous segments.
+    // Returns the number popped.
+    size_t pop_range(Type* out, size_t count);
 
   private:
-    Type m_data[MaxSize];
-    size_t m_back;
+    static constexpr size_t roundUp(size_t size) {
+        size_t capacity = 1;
+        while (capacity < size) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+    static constexpr size_t capacity = roundUp(MaxSize);
+    static constexpr size_t mask = capacity - 1;
+
+    // Copy with memcpy when Type allows it
+    static void copy(Type* dest, const Type* src, size_t count);
+
+    Type m_data[capacity];
+    size_t m_head;
+    size_t m_tail;
 };
 
 template<typename Type, size_t MaxSize>
-ArrayQueue<Type, MaxSize>::ArrayQueue(const ArrayQueue<Type, MaxSize>& queue) {
-    for (size_t i = 0; i <= queue.m_back; i++) {
-        m_data[i] = queue.m_data[i];
+ArrayQueue<Type, MaxSize>::ArrayQueue(const ArrayQueue<Type, MaxSize>& queue) : m_head(0), m_tail(0) {
+    *this = queue;
+}
+
+template<typename Type, size_t MaxSize>
+ArrayQueue<Type, MaxSize>& ArrayQueue<Type, MaxSize>::operator=(const ArrayQueue<Type, MaxSize>& queue) {
+    if (this == &queue) {
+        return *this;
+    }
+    // Same capacity, so copying the whole array keeps every index valid
+    copy(m_data, queue.m_data, capacity);
+    m_head = queue.m_head;
+    m_tail = queue.m_tail;
+    return *this;
+}
+
+template<typename Type, size_t MaxSize>
+void ArrayQueue<Type, MaxSize>::copy(Type* dest, const Type* src, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    if (std::is_trivially_copyable<Type>::value) {
+        std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(Type));
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            dest[i] = src[i];
+        }
     }
-    m_back = queue.m_back;
 }
 
 template<typename Type, size_t MaxSize>
 void ArrayQueue<Type, MaxSize>::push(Type value) {
-    if (m_back == MaxSize - 1) {
+    if (size() == MaxSize) {
 #ifdef _DEBUG
         throw std::out_of_range("Queue is full.");
 #endif// _DEBUG
         return;
     }
-    m_data[++m_back] = value;
+    m_data[m_tail & mask] = value;
+    m_tail++;
 }
 
 template<typename Type, size_t MaxSize>
 Type ArrayQueue<Type, MaxSize>::pop() {
-    if (m_back == -1) {
+    if (empty()) {
         return Type();
     }
-    Type returnValue = m_data[0];
-    for (size_t i = 0; i < m_back; i++) {
-        m_data[i] = m_data[i + 1];
-    }
-    m_back--;
+    Type returnValue = m_data[m_head & mask];
+    m_head++;
     return returnValue;
 }
 
+template<typename Type, size_t MaxSize>
+size_t ArrayQueue<Type, MaxSize>::push_range(const Type* values, size_t count) {
+    if (count > MaxSize - size()) {
+#ifdef _DEBUG
+        throw std::out_of_range("Queue is full.");
+#endif// _DEBUG
+        count = MaxSize - size();
+    }
+    size_t start = m_tail & mask;
+    size_t first = (count < capacity - start) ? count : capacity - start;
+    copy(m_data + start, values, first);
+    copy(m_data, values + first, count - first);
+    m_tail += count;
+    return count;
+}
+
+template<typename Type, size_t MaxSize>
+size_t ArrayQueue<Type, MaxSize>::pop_range(Type* out, size_t count) {
+    if (count > size()) {
+        count = size();
+    }
+    size_t start = m_head & mask;
+    size_t first = (count < capacity - start) ? count : capacity - start;
+    copy(out, m_data + start, first);
+    copy(out + first, m_data, count - first);
+    m_head += count;
+    return count;
+}
+
 #endif
@@ -27,17 +27,40 @@
 #ifndef DS_ARRAY_STACK_H
 #define DS_ARRAY_STACK_H
 
+#include <cstring>
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
+
+// Heap-backed segment ArrayStack spills into past MaxSize
+template<typename Type, bool Spill>
+struct ArrayStackSpill
+{
+    std::unique_ptr<Type[]> m_spill;
+    size_t m_spillSize;
+    size_t m_spillCapacity;
+
+    ArrayStackSpill() : m_spill(nullptr), m_spillSize(0), m_spillCapacity(0) {}
+    inline size_t spilled() const { return m_spillSize; }
+};
+
+// Without Spill there is nothing to store, so the base takes no space
+template<typename Type>
+struct ArrayStackSpill<Type, false>
+{
+    inline size_t spilled() const { return 0; }
+};
 
 // Array implementation of Stack
-template<typename Type, size_t MaxSize = 32>
-class ArrayStack
+// With Spill set, pushes past MaxSize go to a heap-backed segment instead of being dropped.
+template<typename Type, size_t MaxSize = 32, bool Spill = false>
+class ArrayStack : private ArrayStackSpill<Type, Spill>
 {
   public:
     ArrayStack();
-    ArrayStack(const ArrayStack<Type, MaxSize>& as);
-    ArrayStack<Type, MaxSize>& operator=(const ArrayStack<Type, MaxSize>& as);
-    ~ArrayStack();
+    ArrayStack(const ArrayStack<Type, MaxSize, Spill>& as);
+    ArrayStack<Type, MaxSize, Spill>& operator=(const ArrayStack<Type, MaxSize, Spill>& as);
+    ~ArrayStack() {}
 
     // Check if the stack is empty
     inline bool empty() const { return (m_top == -1); }
@@ -48,56 +71,101 @@ class ArrayStack
     // Pop the top value of the ArrayStack
     Type pop();
 
+    // Push count values, values[count - 1] ends up on top. Returns the number pushed.
+    size_t push_n(const Type* values, size_t count);
+
+    // Pop up to count values into out, keeping their stack order so that the
+    // previous top lands in out[n - 1]. Returns the number n popped.
+    size_t pop_n(Type* out, size_t count);
+
     // Get the top value of the ArrayStack
-    inline Type peek() const { return m_data[m_top]; }
+    Type peek() const;
 
     // Get the MaxSize of the ArrayStack
     inline size_t size() const { return MaxSize; }
 
+    // Get the number of elements in the ArrayStack, including spilled ones
+    inline size_t count() const { return m_top + 1 + this->spilled(); }
+
+    // Clear all the elements of the ArrayStack
+    void clear();
+
   private:
+    // Copy with memcpy when Type allows it
+    static void copy(Type* dest, const Type* src, size_t count);
+
+    // Make room for count spilled elements
+    void reserveSpill(size_t count);
+
     size_t m_top;
     Type m_data[MaxSize];
 };
 
-template<typename Type, size_t MaxSize>
-ArrayStack<Type, MaxSize>::ArrayStack() : m_top(-1) {
+template<typename Type, size_t MaxSize, bool Spill>
+ArrayStack<Type, MaxSize, Spill>::ArrayStack() : m_top(-1) {
     static_assert(MaxSize > 0, "ArrayStack MaxSize has to be positive non-zero integer");
 }
 
-template<typename Type, size_t MaxSize>
-ArrayStack<Type, MaxSize>::ArrayStack(const ArrayStack<Type, MaxSize>& as) {
-    if (as.m_top > MaxSize) {
-#ifdef _DEBUG
-        throw std::out_of_range("Top cannot be greater than MaxSize");
-#endif
-        ArrayStack();
+template<typename Type, size_t MaxSize, bool Spill>
+ArrayStack<Type, MaxSize, Spill>::ArrayStack(const ArrayStack<Type, MaxSize, Spill>& as) : ArrayStack() {
+    *this = as;
+}
+
+template<typename Type, size_t MaxSize, bool Spill>
+ArrayStack<Type, MaxSize, Spill>& ArrayStack<Type, MaxSize, Spill>::operator=(const ArrayStack<Type, MaxSize, Spill>& as) {
+    if (this == &as) {
+        return *this;
     }
     m_top = as.m_top;
-    for (size_t i = 0; i <= as.m_top; i++) {
-        m_data[i] = as.m_data[i];
+    copy(m_data, as.m_data, m_top + 1);
+    if constexpr (Spill) {
+        this->m_spillSize = 0;
+        if (as.m_spillSize > 0) {
+            reserveSpill(as.m_spillSize);
+            copy(this->m_spill.get(), as.m_spill.get(), as.m_spillSize);
+            this->m_spillSize = as.m_spillSize;
+        }
     }
+    return *this;
 }
 
-
-template<typename Type, size_t MaxSize>
-ArrayStack<Type, MaxSize>& ArrayStack<Type, MaxSize>::operator=(const ArrayStack<Type, MaxSize>& as) {
-    m_top = as.m_top;
-    for (size_t i = 0; i <= as.m_top; i++) {
-        m_data[i] = as.m_data[i];
+template<typename Type, size_t MaxSize, bool Spill>
+void ArrayStack<Type, MaxSize, Spill>::copy(Type* dest, const Type* src, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    if (std::is_trivially_copyable<Type>::value) {
+        std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(Type));
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            dest[i] = src[i];
+        }
     }
-    return *this;
 }
 
-template<typename Type, size_t MaxSize>
-ArrayStack<Type, MaxSize>::~ArrayStack() {
-    while (m_top > 0) {
-        pop();
+template<typename Type, size_t MaxSize, bool Spill>
+void ArrayStack<Type, MaxSize, Spill>::reserveSpill(size_t count) {
+    if (count <= this->m_spillCapacity) {
+        return;
+    }
+    size_t capacity = (this->m_spillCapacity == 0) ? MaxSize : this->m_spillCapacity;
+    while (capacity < count) {
+        capacity *= 2;
     }
+    std::unique_ptr<Type[]> spill = std::make_unique<Type[]>(capacity);
+    copy(spill.get(), this->m_spill.get(), this->m_spillSize);
+    this->m_spill = std::move(spill);
+    this->m_spillCapacity = capacity;
 }
 
-template<typename Type, size_t MaxSize>
-void ArrayStack<Type, MaxSize>::push(const Type value) {
+template<typename Type, size_t MaxSize, bool Spill>
+void ArrayStack<Type, MaxSize, Spill>::push(const Type value) {
     if (m_top == MaxSize - 1) {
+        if constexpr (Spill) {
+            reserveSpill(this->m_spillSize + 1);
+            this->m_spill[this->m_spillSize++] = value;
+            return;
+        }
 #ifdef _DEBUG
         throw std::out_of_range("Cannot push: ArrayStack MaxSize exceeded");
 #endif
@@ -106,9 +174,14 @@ void ArrayStack<Type, MaxSize>::push(const Type value) {
     m_data[++m_top] = value;
 }
 
-template<typename Type, size_t MaxSize>
-Type ArrayStack<Type, MaxSize>::pop() {
-    if (m_top < 0) {
+template<typename Type, size_t MaxSize, bool Spill>
+Type ArrayStack<Type, MaxSize, Spill>::pop() {
+    if constexpr (Spill) {
+        if (this->m_spillSize > 0) {
+            return this->m_spill[--this->m_spillSize];
+        }
+    }
+    if (empty()) {
 #ifdef _DEBUG
         throw std::out_of_range("Cannot pop: ArrayStack is empty");
 #endif
@@ -118,4 +191,75 @@ Type ArrayStack<Type, MaxSize>::pop() {
     return m_data[m_top + 1];
 }
 
+template<typename Type, size_t MaxSize, bool Spill>
+size_t ArrayStack<Type, MaxSize, Spill>::push_n(const Type* values, size_t count) {
+    size_t inlineCount = MaxSize - (m_top + 1);
+    if (this->spilled() > 0) {
+        inlineCount = 0;
+    }
+    if (inlineCount > count) {
+        inlineCount = count;
+    }
+    copy(m_data + m_top + 1, values, inlineCount);
+    m_top += inlineCount;
+
+    size_t rest = count - inlineCount;
+    if (rest == 0) {
+        return count;
+    }
+    if constexpr (Spill) {
+        reserveSpill(this->m_spillSize + rest);
+        copy(this->m_spill.get() + this->m_spillSize, values + inlineCount, rest);
+        this->m_spillSize += rest;
+        return count;
+    }
+#ifdef _DEBUG
+    throw std::out_of_range("Cannot push: ArrayStack MaxSize exceeded");
+#endif
+    return inlineCount;
+}
+
+template<typename Type, size_t MaxSize, bool Spill>
+size_t ArrayStack<Type, MaxSize, Spill>::pop_n(Type* out, size_t count) {
+    if (count > this->count()) {
+        count = this->count();
+    }
+    size_t spilled = 0;
+    if constexpr (Spill) {
+        // The spilled segment holds the top of the stack, so it fills the end of out
+        spilled = (count < this->m_spillSize) ? count : this->m_spillSize;
+        this->m_spillSize -= spilled;
+        copy(out + count - spilled, this->m_spill.get() + this->m_spillSize, spilled);
+    }
+
+    size_t inlineCount = count - spilled;
+    m_top -= inlineCount;
+    copy(out, m_data + m_top + 1, inlineCount);
+    return count;
+}
+
+template<typename Type, size_t MaxSize, bool Spill>
+Type ArrayStack<Type, MaxSize, Spill>::peek() const {
+    if constexpr (Spill) {
+        if (this->m_spillSize > 0) {
+            return this->m_spill[this->m_spillSize - 1];
+        }
+    }
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("Cannot peek: ArrayStack is empty");
+#endif
+        return Type();
+    }
+    return m_data[m_top];
+}
+
+template<typename Type, size_t MaxSize, bool Spill>
+void ArrayStack<Type, MaxSize, Spill>::clear() {
+    m_top = -1;
+    if constexpr (Spill) {
+        this->m_spillSize = 0;
+    }
+}
+
 #endif
@@ -0,0 +1,202 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_ASYNC_QUEUE_H
+#define DS_ASYNC_QUEUE_H
+
+// Requires C++20 coroutines
+#include <coroutine>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include "RingQueue.h"
+
+// Resumes a waiting consumer right away on the thread that pushed
+struct InlineExecutor
+{
+    void schedule(std::coroutine_handle<> handle) { handle.resume(); }
+};
+
+/* Queue whose pop() is awaited from a coroutine instead of blocking a thread.
+ * A consumer that finds the queue empty is suspended and parked in an intrusive
+ * list inside its own coroutine frame, so an idle consumer costs no thread and no
+ * allocation. push() hands the value straight to the oldest parked consumer and
+ * passes its handle to the Executor, which decides where it resumes: any type with
+ * a schedule(std::coroutine_handle<>) member works.
+ * push, try_pop and close may be called from any thread. A suspended consumer must
+ * not be destroyed before it has been resumed. */
+template<typename Type, typename Executor = InlineExecutor>
+class AsyncQueue
+{
+  public:
+    class PopAwaiter;
+
+    AsyncQueue() : m_executor(), m_waitHead(nullptr), m_waitTail(nullptr), m_closed(false) {}
+    explicit AsyncQueue(Executor executor)
+        : m_executor(std::move(executor)), m_waitHead(nullptr), m_waitTail(nullptr), m_closed(false) {}
+    AsyncQueue(const AsyncQueue<Type, Executor>& queue) = delete;
+    ~AsyncQueue() { close(); }
+
+    AsyncQueue<Type, Executor>& operator=(const AsyncQueue<Type, Executor>& queue) = delete;
+
+    size_t size() const;
+    inline bool empty() const { return size() == 0; }
+
+    // Insert an element, resuming the oldest waiting consumer if there is one.
+    // Returns false if the queue is closed.
+    bool push(const Type value);
+
+    // Remove the first element without waiting. Returns false if the queue is empty.
+    bool try_pop(Type& value);
+
+    // co_await pop() yields the first element, or an empty optional once the queue
+    // is closed and drained
+    inline PopAwaiter pop() { return PopAwaiter(*this); }
+
+    // Stop accepting elements and resume every waiting consumer with no value
+    void close();
+
+  private:
+    // Move the first element into value, the mutex must be held
+    bool take(std::optional<Type>& value);
+
+    Executor m_executor;
+    mutable std::mutex m_mutex;
+    RingQueue<Type> m_queue;
+    PopAwaiter* m_waitHead;
+    PopAwaiter* m_waitTail;
+    bool m_closed;
+};
+
+template<typename Type, typename Executor>
+class AsyncQueue<Type, Executor>::PopAwaiter
+{
+  public:
+    PopAwaiter(AsyncQueue<Type, Executor>& queue_) : queue(queue_), next(nullptr) {}
+
+    bool await_ready();
+    bool await_suspend(std::coroutine_handle<> handle_);
+    std::optional<Type> await_resume() { return std::move(value); }
+
+  private:
+    AsyncQueue<Type, Executor>& queue;
+    std::coroutine_handle<> handle;
+    std::optional<Type> value;
+    PopAwaiter* next;
+
+    friend class AsyncQueue<Type, Executor>;
+};
+
+template<typename Type, typename Executor>
+bool AsyncQueue<Type, Executor>::PopAwaiter::await_ready() {
+    std::lock_guard<std::mutex> lock(queue.m_mutex);
+    return queue.take(value) || queue.m_closed;
+}
+
+template<typename Type, typename Executor>
+bool AsyncQueue<Type, Executor>::PopAwaiter::await_suspend(std::coroutine_handle<> handle_) {
+    std::lock_guard<std::mutex> lock(queue.m_mutex);
+    // An element may have arrived since await_ready
+    if (queue.take(value) || queue.m_closed) {
+        return false;
+    }
+    handle = handle_;
+    if (queue.m_waitTail == nullptr) {
+        queue.m_waitHead = this;
+    } else {
+        queue.m_waitTail->next = this;
+    }
+    queue.m_waitTail = this;
+    return true;
+}
+
+template<typename Type, typename Executor>
+bool AsyncQueue<Type, Executor>::take(std::optional<Type>& value) {
+    if (m_queue.empty()) {
+        return false;
+    }
+    value = m_queue.pop();
+    return true;
+}
+
+template<typename Type, typename Executor>
+size_t AsyncQueue<Type, Executor>::size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_queue.size();
+}
+
+template<typename Type, typename Executor>
+bool AsyncQueue<Type, Executor>::push(const Type value) {
+    PopAwaiter* waiter;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_closed) {
+            return false;
+        }
+        waiter = m_waitHead;
+        if (waiter == nullptr) {
+            m_queue.push(value);
+            return true;
+        }
+        m_waitHead = waiter->next;
+        if (m_waitHead == nullptr) {
+            m_waitTail = nullptr;
+        }
+        waiter->value = value;
+    }
+    // Resume outside the lock, the consumer may push or pop again right away
+    m_executor.schedule(waiter->handle);
+    return true;
+}
+
+template<typename Type, typename Executor>
+bool AsyncQueue<Type, Executor>::try_pop(Type& value) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_queue.empty()) {
+        return false;
+    }
+    value = m_queue.pop();
+    return true;
+}
+
+template<typename Type, typename Executor>
+void AsyncQueue<Type, Executor>::close() {
+    PopAwaiter* waiter;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed = true;
+        waiter = m_waitHead;
+        m_waitHead = m_waitTail = nullptr;
+    }
+    while (waiter != nullptr) {
+        // Read next first, resuming may destroy the awaiter
+        PopAwaiter* next = waiter->next;
+        m_executor.schedule(waiter->handle);
+        waiter = next;
+    }
+}
+
+#endif
@@ -0,0 +1,464 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_CACHE_H
+#define DS_CACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include "DoublyLinkedList.h"
+#include "HashIndex.h"
+
+// Counters kept by every cache
+struct CacheStats
+{
+    size_t hits;
+    size_t misses;
+    size_t evictions;
+
+    CacheStats() : hits(0), misses(0), evictions(0) {}
+};
+
+/* Bounded Least Recently Used cache.
+ * A DoublyLinkedList keeps the entries in recency order and a HashIndex maps
+ * keys to their nodes, so get, put and eviction are all O(1). */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class LRUCache
+{
+  public:
+    typedef Key KeyType;
+    typedef Value ValueType;
+    typedef Hash HashType;
+
+    LRUCache(size_t capacity);
+    LRUCache(const LRUCache<Key, Value, Hash>& cache) = delete;
+    ~LRUCache() { clear(); }
+
+    inline bool empty() const { return m_index.empty(); }
+    inline size_t size() const { return m_index.size(); }
+    inline size_t capacity() const { return m_capacity; }
+
+    // Get the cached value and mark it most recently used, nullptr on a miss
+    Value* get(const Key& key);
+
+    // Check for key without touching the recency order or the counters
+    inline bool contains(const Key& key) const { return m_index.find(key) != nullptr; }
+
+    // Insert or overwrite key, evicting the least recently used entry when full
+    void put(const Key& key, const Value& value);
+
+    bool erase(const Key& key);
+
+    inline const CacheStats& stats() const { return m_stats; }
+    inline void resetStats() { m_stats = CacheStats(); }
+
+    void clear();
+
+  private:
+    struct Entry
+    {
+        Key key;
+        Value value;
+
+        Entry() : key(Key()), value(Value()) {}
+        Entry(const Key& key_, const Value& value_) : key(key_), value(value_) {}
+    };
+    typedef typename DoublyLinkedList<Entry>::Node Node;
+
+    // Most recently used entry at the head
+    DoublyLinkedList<Entry> m_list;
+    HashIndex<Key, Node*, Hash> m_index;
+    size_t m_capacity;
+    CacheStats m_stats;
+};
+
+template<typename Key, typename Value, typename Hash>
+LRUCache<Key, Value, Hash>::LRUCache(size_t capacity) : m_index(capacity), m_capacity(capacity) {}
+
+template<typename Key, typename Value, typename Hash>
+Value* LRUCache<Key, Value, Hash>::get(const Key& key) {
+    Node** node = m_index.find(key);
+    if (node == nullptr) {
+        m_stats.misses++;
+        return nullptr;
+    }
+    m_stats.hits++;
+    m_list.moveToHead(*node);
+    return &(*node)->value.value;
+}
+
+template<typename Key, typename Value, typename Hash>
+void LRUCache<Key, Value, Hash>::put(const Key& key, const Value& value) {
+    if (m_capacity == 0) {
+        return;
+    }
+    Node** node = m_index.find(key);
+    if (node != nullptr) {
+        (*node)->value.value = value;
+        m_list.moveToHead(*node);
+        return;
+    }
+    if (m_index.size() == m_capacity) {
+        m_index.erase(m_list.tail()->value.key);
+        m_list.removeTail();
+        m_stats.evictions++;
+    }
+    m_index.insert(key, m_list.unshift(Entry(key, value)));
+}
+
+template<typename Key, typename Value, typename Hash>
+bool LRUCache<Key, Value, Hash>::erase(const Key& key) {
+    Node** node = m_index.find(key);
+    if (node == nullptr) {
+        return false;
+    }
+    m_list.remove(*node);
+    m_index.erase(key);
+    return true;
+}
+
+template<typename Key, typename Value, typename Hash>
+void LRUCache<Key, Value, Hash>::clear() {
+    m_list.clear();
+    m_index.clear();
+}
+
+/* Bounded Least Frequently Used cache, ties broken by recency.
+ * The list is ordered by ascending use count and every count keeps a pointer
+ * to the last node of its run, so a hit moves a node one run up in O(1). */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class LFUCache
+{
+  public:
+    typedef Key KeyType;
+    typedef Value ValueType;
+    typedef Hash HashType;
+
+    LFUCache(size_t capacity);
+    LFUCache(const LFUCache<Key, Value, Hash>& cache) = delete;
+    ~LFUCache() { clear(); }
+
+    inline bool empty() const { return m_index.empty(); }
+    inline size_t size() const { return m_index.size(); }
+    inline size_t capacity() const { return m_capacity; }
+
+    // Get the cached value and count the use, nullptr on a miss
+    Value* get(const Key& key);
+
+    // Check for key without counting a use or touching the counters
+    inline bool contains(const Key& key) const { return m_index.find(key) != nullptr; }
+
+    // Insert or overwrite key, evicting the least frequently used entry when full
+    void put(const Key& key, const Value& value);
+
+    bool erase(const Key& key);
+
+    inline const CacheStats& stats() const { return m_stats; }
+    inline void resetStats() { m_stats = CacheStats(); }
+
+    void clear();
+
+  private:
+    struct Entry
+    {
+        Key key;
+        Value value;
+        size_t uses;
+
+        Entry() : key(Key()), value(Value()), uses(0) {}
+        Entry(const Key& key_, const Value& value_) : key(key_), value(value_), uses(1) {}
+    };
+    typedef typename DoublyLinkedList<Entry>::Node Node;
+
+    // Take node out of the run of its use count
+    void leaveRun(Node* node);
+
+    // Count one more use of node and move it to the end of the next run
+    void touch(Node* node);
+
+    // Eviction candidate at the head
+    DoublyLinkedList<Entry> m_list;
+    HashIndex<Key, Node*, Hash> m_index;
+    HashIndex<size_t, Node*> m_runTail;
+    size_t m_capacity;
+    CacheStats m_stats;
+};
+
+template<typename Key, typename Value, typename Hash>
+LFUCache<Key, Value, Hash>::LFUCache(size_t capacity) : m_index(capacity), m_capacity(capacity) {}
+
+template<typename Key, typename Value, typename Hash>
+void LFUCache<Key, Value, Hash>::leaveRun(Node* node) {
+    size_t uses = node->value.uses;
+    Node** tail = m_runTail.find(uses);
+    if (*tail != node) {
+        return;
+    }
+    if (node->prev != nullptr && node->prev->value.uses == uses) {
+        *tail = node->prev;
+    } else {
+        m_runTail.erase(uses);
+    }
+}
+
+template<typename Key, typename Value, typename Hash>
+void LFUCache<Key, Value, Hash>::touch(Node* node) {
+    Node* runEnd = *m_runTail.find(node->value.uses);
+    leaveRun(node);
+    node->value.uses++;
+
+    Node** nextTail = m_runTail.find(node->value.uses);
+    if (nextTail != nullptr) {
+        m_list.moveAfter(node, *nextTail);
+        *nextTail = node;
+        return;
+    }
+    // No run for the new count yet: it starts right after the old run
+    if (runEnd != node) {
+        m_list.moveAfter(node, runEnd);
+    }
+    m_runTail.insert(node->value.uses, node);
+}
+
+template<typename Key, typename Value, typename Hash>
+Value* LFUCache<Key, Value, Hash>::get(const Key& key) {
+    Node** node = m_index.find(key);
+    if (node == nullptr) {
+        m_stats.misses++;
+        return nullptr;
+    }
+    m_stats.hits++;
+    Node* found = *node;
+    touch(found);
+    return &found->value.value;
+}
+
+template<typename Key, typename Value, typename Hash>
+void LFUCache<Key, Value, Hash>::put(const Key& key, const Value& value) {
+    if (m_capacity == 0) {
+        return;
+    }
+    Node** node = m_index.find(key);
+    if (node != nullptr) {
+        Node* found = *node;
+        found->value.value = value;
+        touch(found);
+        return;
+    }
+    if (m_index.size() == m_capacity) {
+        Node* victim = m_list.head();
+        leaveRun(victim);
+        m_index.erase(victim->value.key);
+        m_list.removeHead();
+        m_stats.evictions++;
+    }
+
+    Node* newNode;
+    Node** tail = m_runTail.find(1);
+    if (tail != nullptr) {
+        newNode = m_list.insertAfter(*tail, Entry(key, value));
+        *tail = newNode;
+    } else {
+        newNode = m_list.unshift(Entry(key, value));
+        m_runTail.insert(1, newNode);
+    }
+    m_index.insert(key, newNode);
+}
+
+template<typename Key, typename Value, typename Hash>
+bool LFUCache<Key, Value, Hash>::erase(const Key& key) {
+    Node** node = m_index.find(key);
+    if (node == nullptr) {
+        return false;
+    }
+    Node* found = *node;
+    leaveRun(found);
+    m_index.erase(key);
+    m_list.remove(found);
+    return true;
+}
+
+template<typename Key, typename Value, typename Hash>
+void LFUCache<Key, Value, Hash>::clear() {
+    m_list.clear();
+    m_index.clear();
+    m_runTail.clear();
+}
+
+/* Thread-safe cache split into independently locked shards.
+ * Cache is LRUCache or LFUCache. The capacity is split exactly: each shard gets
+ * capacity / Shards entries and the first capacity % Shards shards one more. Keep
+ * capacity at least Shards, otherwise some shards hold nothing and the keys that
+ * hash to them are never cached. */
+template<typename Cache, size_t Shards = 16>
+class ShardedCache
+{
+  public:
+    typedef typename Cache::KeyType Key;
+    typedef typename Cache::ValueType Value;
+    typedef typename Cache::HashType Hash;
+
+    ShardedCache(size_t capacity);
+    ShardedCache(const ShardedCache<Cache, Shards>& cache) = delete;
+
+    size_t size() const;
+    size_t capacity() const;
+
+    // Copy the cached value into value. Returns false on a miss.
+    bool get(const Key& key, Value& value);
+    bool contains(const Key& key) const;
+    void put(const Key& key, const Value& value);
+    bool erase(const Key& key);
+
+    // Counters summed over all shards
+    CacheStats stats() const;
+    void resetStats();
+
+    void clear();
+
+  private:
+    // One cache line per shard so neighbouring locks don't false-share
+    struct alignas(64) Shard
+    {
+        mutable std::mutex mutex;
+        Cache cache;
+
+        Shard(size_t capacity) : cache(capacity) {}
+    };
+
+    Shard& shardOf(const Key& key) const;
+
+    std::unique_ptr<Shard> m_shards[Shards];
+    Hash m_hash;
+};
+
+template<typename Key, typename Value, size_t Shards = 16, typename Hash = std::hash<Key>>
+using ShardedLRUCache = ShardedCache<LRUCache<Key, Value, Hash>, Shards>;
+
+template<typename Key, typename Value, size_t Shards = 16, typename Hash = std::hash<Key>>
+using ShardedLFUCache = ShardedCache<LFUCache<Key, Value, Hash>, Shards>;
+
+template<typename Cache, size_t Shards>
+ShardedCache<Cache, Shards>::ShardedCache(size_t capacity) {
+    static_assert(Shards > 0, "ShardedCache Shards has to be positive non-zero integer");
+    size_t perShard = capacity / Shards;
+    size_t extra = capacity % Shards;
+    for (size_t i = 0; i < Shards; i++) {
+        m_shards[i] = std::make_unique<Shard>(perShard + (i < extra ? 1 : 0));
+    }
+}
+
+template<typename Cache, size_t Shards>
+typename ShardedCache<Cache, Shards>::Shard& ShardedCache<Cache, Shards>::shardOf(const Key& key) const {
+    // Use the high bits so shard choice is independent of the slot inside the shard
+    uint64_t hash = static_cast<uint64_t>(m_hash(key)) * 0xFF51AFD7ED558CCDULL;
+    return *m_shards[(hash >> 32) % Shards];
+}
+
+template<typename Cache, size_t Shards>
+size_t ShardedCache<Cache, Shards>::size() const {
+    size_t total = 0;
+    for (size_t i = 0; i < Shards; i++) {
+        std::lock_guard<std::mutex> lock(m_shards[i]->mutex);
+        total += m_shards[i]->cache.size();
+    }
+    return total;
+}
+
+template<typename Cache, size_t Shards>
+size_t ShardedCache<Cache, Shards>::capacity() const {
+    size_t total = 0;
+    for (size_t i = 0; i < Shards; i++) {
+        total += m_shards[i]->cache.capacity();
+    }
+    return total;
+}
+
+template<typename Cache, size_t Shards>
+bool ShardedCache<Cache, Shards>::get(const Key& key, Value& value) {
+    Shard& shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Value* found = shard.cache.get(key);
+    if (found == nullptr) {
+        return false;
+    }
+    value = *found;
+    return true;
+}
+
+template<typename Cache, size_t Shards>
+bool ShardedCache<Cache, Shards>::contains(const Key& key) const {
+    Shard& shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.cache.contains(key);
+}
+
+template<typename Cache, size_t Shards>
+void ShardedCache<Cache, Shards>::put(const Key& key, const Value& value) {
+    Shard& shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.cache.put(key, value);
+}
+
+template<typename Cache, size_t Shards>
+bool ShardedCache<Cache, Shards>::erase(const Key& key) {
+    Shard& shard = shardOf(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.cache.erase(key);
+}
+
+template<typename Cache, size_t Shards>
+CacheStats ShardedCache<Cache, Shards>::stats() const {
+    CacheStats total;
+    for (size_t i = 0; i < Shards; i++) {
+        std::lock_guard<std::mutex> lock(m_shards[i]->mutex);
+        const CacheStats& stats = m_shards[i]->cache.stats();
+        total.hits += stats.hits;
+        total.misses += stats.misses;
+        total.evictions += stats.evictions;
+    }
+    return total;
+}
+
+template<typename Cache, size_t Shards>
+void ShardedCache<Cache, Shards>::resetStats() {
+    for (size_t i = 0; i < Shards; i++) {
+        std::lock_guard<std::mutex> lock(m_shards[i]->mutex);
+        m_shards[i]->cache.resetStats();
+    }
+}
+
+template<typename Cache, size_t Shards>
+void ShardedCache<Cache, Shards>::clear() {
+    for (size_t i = 0; i < Shards; i++) {
+        std::lock_guard<std::mutex> lock(m_shards[i]->mutex);
+        m_shards[i]->cache.clear();
+    }
+}
+
+#endif
@@ -0,0 +1,214 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_CHANNEL_H
+#define DS_CHANNEL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include "RingQueue.h"
+
+/* Bounded blocking channel between pipeline stages, built on RingQueue.
+ * A full channel blocks producers (backpressure) and an empty one blocks consumers.
+ * Before sleeping on a condition variable a thread spins for a while on a lock-free
+ * size counter, so a busy pipeline hands items over without a syscall, and a sleeper
+ * is only notified when someone is actually waiting.
+ * close() wakes everyone: pushes fail from then on and pops drain what is left. */
+template<typename Type>
+class Channel
+{
+  public:
+    Channel(size_t capacity, size_t spins = 256);
+    Channel(const Channel<Type>& channel) = delete;
+
+    Channel<Type>& operator=(const Channel<Type>& channel) = delete;
+
+    inline size_t capacity() const { return m_capacity; }
+    inline size_t size() const { return m_size.load(std::memory_order_relaxed); }
+    inline bool empty() const { return size() == 0; }
+    inline bool closed() const { return m_closed.load(std::memory_order_acquire); }
+
+    // Wait for room and push. Returns false if the channel is closed.
+    bool push(const Type& value);
+
+    // Push without waiting. Returns false if the channel is full or closed.
+    bool try_push(const Type& value);
+
+    // Wait for a value. Returns false once the channel is closed and drained.
+    bool pop(Type& value);
+
+    // Pop without waiting. Returns false if the channel is empty.
+    bool try_pop(Type& value);
+
+    // Wait for at least one value and pop up to max of them into out.
+    // Returns 0 once the channel is closed and drained.
+    size_t pop_bulk(Type* out, size_t max);
+
+    // Stop accepting values and wake every waiting thread
+    void close();
+
+  private:
+    // Spin until ready() holds, giving up after m_spins checks
+    template<typename Predicate>
+    void spin(Predicate ready) const;
+
+    // Hand the lock back and wake the other side if it sleeps
+    void wakeProducers(std::unique_lock<std::mutex>& lock, size_t freed);
+    void wakeConsumer(std::unique_lock<std::mutex>& lock);
+
+    RingQueue<Type> m_queue;
+    size_t m_capacity;
+    size_t m_spins;
+    std::mutex m_mutex;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_notFull;
+    size_t m_waitingProducers;
+    size_t m_waitingConsumers;
+    std::atomic<size_t> m_size;
+    std::atomic<bool> m_closed;
+};
+
+template<typename Type>
+Channel<Type>::Channel(size_t capacity, size_t spins)
+    : m_queue(capacity), m_capacity(capacity == 0 ? 1 : capacity), m_spins(spins),
+      m_waitingProducers(0), m_waitingConsumers(0), m_size(0), m_closed(false) {}
+
+template<typename Type>
+template<typename Predicate>
+void Channel<Type>::spin(Predicate ready) const {
+    for (size_t i = 0; i < m_spins; i++) {
+        if (ready()) {
+            return;
+        }
+    }
+}
+
+template<typename Type>
+void Channel<Type>::wakeProducers(std::unique_lock<std::mutex>& lock, size_t freed) {
+    bool waiting = m_waitingProducers > 0;
+    lock.unlock();
+    if (!waiting) {
+        return;
+    }
+    if (freed == 1) {
+        m_notFull.notify_one();
+    } else {
+        m_notFull.notify_all();
+    }
+}
+
+template<typename Type>
+void Channel<Type>::wakeConsumer(std::unique_lock<std::mutex>& lock) {
+    bool waiting = m_waitingConsumers > 0;
+    lock.unlock();
+    if (waiting) {
+        m_notEmpty.notify_one();
+    }
+}
+
+template<typename Type>
+bool Channel<Type>::push(const Type& value) {
+    spin([this] { return size() < m_capacity || closed(); });
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto ready = [this] { return m_queue.size() < m_capacity || m_closed.load(std::memory_order_relaxed); };
+    if (!ready()) {
+        m_waitingProducers++;
+        m_notFull.wait(lock, ready);
+        m_waitingProducers--;
+    }
+    if (m_closed.load(std::memory_order_relaxed)) {
+        return false;
+    }
+    m_queue.push(value);
+    m_size.store(m_queue.size(), std::memory_order_relaxed);
+    wakeConsumer(lock);
+    return true;
+}
+
+template<typename Type>
+bool Channel<Type>::try_push(const Type& value) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_closed.load(std::memory_order_relaxed) || m_queue.size() >= m_capacity) {
+        return false;
+    }
+    m_queue.push(value);
+    m_size.store(m_queue.size(), std::memory_order_relaxed);
+    wakeConsumer(lock);
+    return true;
+}
+
+template<typename Type>
+bool Channel<Type>::pop(Type& value) {
+    return pop_bulk(&value, 1) == 1;
+}
+
+template<typename Type>
+bool Channel<Type>::try_pop(Type& value) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_queue.empty()) {
+        return false;
+    }
+    value = m_queue.pop();
+    m_size.store(m_queue.size(), std::memory_order_relaxed);
+    wakeProducers(lock, 1);
+    return true;
+}
+
+template<typename Type>
+size_t Channel<Type>::pop_bulk(Type* out, size_t max) {
+    if (max == 0) {
+        return 0;
+    }
+    spin([this] { return size() > 0 || closed(); });
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto ready = [this] { return !m_queue.empty() || m_closed.load(std::memory_order_relaxed); };
+    if (!ready()) {
+        m_waitingConsumers++;
+        m_notEmpty.wait(lock, ready);
+        m_waitingConsumers--;
+    }
+    size_t count = m_queue.pop_range(out, max);
+    m_size.store(m_queue.size(), std::memory_order_relaxed);
+    if (count > 0) {
+        wakeProducers(lock, count);
+    }
+    return count;
+}
+
+template<typename Type>
+void Channel<Type>::close() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_closed.store(true, std::memory_order_release);
+    }
+    m_notEmpty.notify_all();
+    m_notFull.notify_all();
+}
+
+#endif
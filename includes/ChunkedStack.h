@@ -0,0 +1,301 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_CHUNKED_STACK_H
+#define DS_CHUNKED_STACK_H
+
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+/* Stack stored in a chain of fixed-size contiguous chunks.
+ * push and pop only touch the heap when crossing a chunk boundary, and an emptied
+ * chunk is kept as a spare so pushing and popping around a boundary does not thrash. */
+template<typename Type, size_t ChunkSize = 256>
+class ChunkedStack
+{
+  public:
+    ChunkedStack();
+    ChunkedStack(const ChunkedStack<Type, ChunkSize>& s);
+    ChunkedStack(ChunkedStack<Type, ChunkSize>&& s) noexcept;
+    ~ChunkedStack();
+
+    ChunkedStack<Type, ChunkSize>& operator=(const ChunkedStack<Type, ChunkSize>& s);
+    ChunkedStack<Type, ChunkSize>& operator=(ChunkedStack<Type, ChunkSize>&& s) noexcept;
+
+    // Check if the stack is empty
+    inline bool empty() const { return (m_size == 0); }
+
+    // Get the number of elements in the stack
+    inline size_t size() const { return m_size; }
+
+    // Get the number of elements the stack holds without allocating
+    inline size_t capacity() const { return m_chunks * ChunkSize; }
+
+    // Push a value to the top of the ChunkedStack
+    void push(const Type value);
+
+    // Pop the top value of the ChunkedStack
+    Type pop();
+
+    // Get the top value of the ChunkedStack
+    Type peek() const;
+
+    // Make room for count elements. Reserved chunks are kept when the stack shrinks.
+    void reserve(size_t count);
+
+    // Free every spare chunk and go back to keeping a single spare
+    void shrink_to_fit();
+
+    // Clear all the elements of the ChunkedStack, keeping the chunks for the refill.
+    // Only reserve changes how many spares are kept once the stack shrinks again.
+    void clear();
+
+  private:
+    struct Chunk
+    {
+        Chunk* prev;
+        alignas(Type) unsigned char storage[sizeof(Type) * ChunkSize];
+
+        Chunk(Chunk* prev_) : prev(prev_) {}
+        inline Type* slot(size_t pos) { return reinterpret_cast<Type*>(storage) + pos; }
+        inline const Type* slot(size_t pos) const { return reinterpret_cast<const Type*>(storage) + pos; }
+    };
+
+    // Move to a fresh chunk once the top chunk is full
+    void pushChunk();
+
+    // Drop the empty top chunk into the spare list, or free it
+    void popChunk();
+
+    void copyFrom(const ChunkedStack<Type, ChunkSize>& s);
+    void release();
+
+    Chunk* m_top;
+    Chunk* m_spare;
+    // Elements in the top chunk
+    size_t m_count;
+    size_t m_size;
+    // Chunks allocated, including spares
+    size_t m_chunks;
+    size_t m_spares;
+    size_t m_keepSpares;
+};
+
+template<typename Type, size_t ChunkSize>
+ChunkedStack<Type, ChunkSize>::ChunkedStack()
+    : m_top(nullptr), m_spare(nullptr), m_count(0), m_size(0), m_chunks(0), m_spares(0), m_keepSpares(1) {
+    static_assert(ChunkSize > 0, "ChunkedStack ChunkSize has to be positive non-zero integer");
+}
+
+template<typename Type, size_t ChunkSize>
+ChunkedStack<Type, ChunkSize>::ChunkedStack(const ChunkedStack<Type, ChunkSize>& s) : ChunkedStack() {
+    copyFrom(s);
+}
+
+template<typename Type, size_t ChunkSize>
+ChunkedStack<Type, ChunkSize>::ChunkedStack(ChunkedStack<Type, ChunkSize>&& s) noexcept
+    : m_top(s.m_top), m_spare(s.m_spare), m_count(s.m_count), m_size(s.m_size), m_chunks(s.m_chunks),
+      m_spares(s.m_spares), m_keepSpares(s.m_keepSpares) {
+    s.m_top = s.m_spare = nullptr;
+    s.m_count = s.m_size = s.m_chunks = s.m_spares = 0;
+    s.m_keepSpares = 1;
+}
+
+template<typename Type, size_t ChunkSize>
+ChunkedStack<Type, ChunkSize>::~ChunkedStack() {
+    release();
+}
+
+template<typename Type, size_t ChunkSize>
+ChunkedStack<Type, ChunkSize>& ChunkedStack<Type, ChunkSize>::operator=(const ChunkedStack<Type, ChunkSize>& s) {
+    if (this != &s) {
+        clear();
+        copyFrom(s);
+    }
+    return *this;
+}
+
+template<typename Type, size_t ChunkSize>
+ChunkedStack<Type, ChunkSize>& ChunkedStack<Type, ChunkSize>::operator=(ChunkedStack<Type, ChunkSize>&& s) noexcept {
+    if (this != &s) {
+        release();
+        m_top = s.m_top;
+        m_spare = s.m_spare;
+        m_count = s.m_count;
+        m_size = s.m_size;
+        m_chunks = s.m_chunks;
+        m_spares = s.m_spares;
+        m_keepSpares = s.m_keepSpares;
+        s.m_top = s.m_spare = nullptr;
+        s.m_count = s.m_size = s.m_chunks = s.m_spares = 0;
+        s.m_keepSpares = 1;
+    }
+    return *this;
+}
+
+template<typename Type, size_t ChunkSize>
+void ChunkedStack<Type, ChunkSize>::copyFrom(const ChunkedStack<Type, ChunkSize>& s) {
+    // Chunks are chained top-down, so collect them before copying bottom-up
+    size_t used = (s.m_size + ChunkSize - 1) / ChunkSize;
+    std::unique_ptr<const Chunk*[]> chunks = std::make_unique<const Chunk*[]>(used);
+    size_t pos = used;
+    for (const Chunk* chunk = s.m_top; chunk != nullptr; chunk = chunk->prev) {
+        chunks[--pos] = chunk;
+    }
+    reserve(s.m_size);
+    for (size_t i = 0; i < used; i++) {
+        size_t count = (i == used - 1) ? s.m_count : ChunkSize;
+        for (size_t j = 0; j < count; j++) {
+            push(*chunks[i]->slot(j));
+        }
+    }
+}
+
+template<typename Type, size_t ChunkSize>
+void ChunkedStack<Type, ChunkSize>::pushChunk() {
+    Chunk* chunk = m_spare;
+    if (chunk != nullptr) {
+        m_spare = chunk->prev;
+        m_spares--;
+        chunk->prev = m_top;
+    } else {
+        chunk = new Chunk(m_top);
+        m_chunks++;
+    }
+    m_top = chunk;
+    m_count = 0;
+}
+
+template<typename Type, size_t ChunkSize>
+void ChunkedStack<Type, ChunkSize>::popChunk() {
+    Chunk* chunk = m_top;
+    m_top = chunk->prev;
+    m_count = (m_top == nullptr) ? 0 : ChunkSize;
+    if (m_spares < m_keepSpares) {
+        chunk->prev = m_spare;
+        m_spare = chunk;
+        m_spares++;
+    } else {
+        delete chunk;
+        m_chunks--;
+    }
+}
+
+template<typename Type, size_t ChunkSize>
+void ChunkedStack<Type, ChunkSize>::push(const Type value) {
+    bool fresh = (m_top == nullptr || m_count == ChunkSize);
+    if (fresh) {
+        pushChunk();
+    }
+    try {
+        new (m_top->slot(m_count)) Type(value);
+    } catch (...) {
+        // Leave no empty chunk on top, pop relies on m_count > 0 there
+        if (fresh) {
+            popChunk();
+        }
+        throw;
+    }
+    m_count++;
+    m_size++;
+}
+
+template<typename Type, size_t ChunkSize>
+Type ChunkedStack<Type, ChunkSize>::pop() {
+    if (m_size == 0) {
+#ifdef _DEBUG
+        throw std::out_of_range("Cannot pop: ChunkedStack is empty");
+#endif
+        return Type();
+    }
+    Type* top = m_top->slot(--m_count);
+    Type value = std::move(*top);
+    top->~Type();
+    m_size--;
+    if (m_count == 0) {
+        popChunk();
+    }
+    return value;
+}
+
+template<typename Type, size_t ChunkSize>
+Type ChunkedStack<Type, ChunkSize>::peek() const {
+    if (m_size == 0) {
+#ifdef _DEBUG
+        throw std::out_of_range("Cannot peek: ChunkedStack is empty");
+#endif
+        return Type();
+    }
+    return *m_top->slot(m_count - 1);
+}
+
+template<typename Type, size_t ChunkSize>
+void ChunkedStack<Type, ChunkSize>::reserve(size_t count) {
+    size_t needed = (count + ChunkSize - 1) / ChunkSize;
+    while (m_chunks < needed) {
+        Chunk* chunk = new Chunk(m_spare);
+        m_spare = chunk;
+        m_spares++;
+        m_chunks++;
+    }
+    if (m_spares > m_keepSpares) {
+        m_keepSpares = m_spares;
+    }
+}
+
+template<typename Type, size_t ChunkSize>
+void ChunkedStack<Type, ChunkSize>::shrink_to_fit() {
+    while (m_spare != nullptr) {
+        Chunk* chunk = m_spare;
+        m_spare = chunk->prev;
+        delete chunk;
+        m_chunks--;
+    }
+    m_spares = 0;
+    m_keepSpares = 1;
+}
+
+template<typename Type, size_t ChunkSize>
+void ChunkedStack<Type, ChunkSize>::clear() {
+    // Keep every chunk on the spare list so refilling does not allocate. Extra
+    // spares are used up by the refill and trimmed again as it shrinks.
+    size_t keepSpares = m_keepSpares;
+    m_keepSpares = m_chunks;
+    while (m_size > 0) {
+        pop();
+    }
+    m_keepSpares = keepSpares;
+}
+
+template<typename Type, size_t ChunkSize>
+void ChunkedStack<Type, ChunkSize>::release() {
+    clear();
+    shrink_to_fit();
+}
+
+#endif
@@ -0,0 +1,508 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_COMPACT_LIST_H
+#define DS_COMPACT_LIST_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+/* DoublyLinkedList stored in one contiguous growable arena.
+ * Nodes are linked by 32-bit slot indices instead of pointers and removed slots
+ * are recycled through a free-list. Slot indices stay valid until compact().
+ *
+ * A Handle is a slot index plus the generation of the slot. Every slot counts its
+ * reuses, so a handle to a removed node is detected in O(1) instead of touching
+ * whatever node took its slot. Handles are safe to keep across compact() and clear(). */
+template<typename Type>
+class CompactList
+{
+  public:
+    typedef uint32_t Index;
+    static constexpr Index npos = UINT32_MAX;
+
+    struct Handle
+    {
+        Index index;
+        uint32_t generation;
+
+        Handle() : index(npos), generation(0) {}
+        Handle(Index index_, uint32_t generation_) : index(index_), generation(generation_) {}
+    };
+
+    CompactList();
+    CompactList(Type values[], size_t size);
+    CompactList(std::initializer_list<Type> values);
+    CompactList(const CompactList<Type>& list);
+    CompactList(CompactList<Type>&& list) noexcept;
+    ~CompactList() { clear(); }
+
+    CompactList<Type>& operator=(const CompactList<Type>& list);
+    CompactList<Type>& operator=(CompactList<Type>&& list) noexcept;
+
+    inline bool empty() const { return (m_size == 0); }
+    inline size_t size() const { return m_size; }
+    inline size_t capacity() const { return m_capacity; }
+
+    inline Index head() const { return m_head; }
+    inline Index tail() const { return m_tail; }
+    inline Index next(Index node) const { return m_slots[node].next; }
+    inline Index prev(Index node) const { return m_slots[node].prev; }
+    inline Type& value(Index node) { return m_slots[node].value; }
+    inline const Type& value(Index node) const { return m_slots[node].value; }
+
+    // The insert functions return the slot of the new node
+    Index insert(Type value);
+    Index unshift(Type value);
+    Index insertBefore(Index node, Type value);
+    Index insertAfter(Index node, Type value);
+
+    // Inserts a value such that the list is in ascending order
+    Index priorityInsert(Type value);
+
+    // Get the handle of a live node
+    inline Handle handle(Index node) const { return Handle(node, m_slots[node].generation); }
+
+    // Check if the node behind the handle is still in the list
+    bool valid(Handle node) const;
+
+    // Get the slot of the node behind the handle, npos if it was removed
+    inline Index resolve(Handle node) const { return valid(node) ? node.index : npos; }
+
+    // Handle versions of the node functions. Stale handles are rejected.
+    Type* get(Handle node) const;
+    Handle insertBefore(Handle node, Type value);
+    Handle insertAfter(Handle node, Type value);
+    bool remove(Handle node);
+
+    Type getHead() const;
+    Type getTail() const;
+
+    bool removeHead();
+    bool removeTail();
+    bool remove(Index node);
+    bool remove(Type value);
+
+    // Make room for count nodes without growing the arena
+    void reserve(size_t count);
+
+    // Move the nodes to slots 0..size()-1 in list order so traversal is sequential.
+    // Invalidates every slot index handed out before.
+    void compact();
+
+    void clear();
+
+  private:
+    struct Slot
+    {
+        Type value;
+        Index next;
+        Index prev;
+        // Odd while the slot holds a node, bumped on every allocate and remove
+        uint32_t generation;
+
+        Slot() : value(Type()), next(npos), prev(npos), generation(0) {}
+    };
+
+    Index allocate(Type value);
+    void grow(size_t capacity);
+    void copyFrom(const CompactList<Type>& list);
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_capacity;
+    size_t m_size;
+    // Slots at or above m_end hold no node; their generation is 0 or the floor left by compact()
+    Index m_end;
+    Index m_free;
+    Index m_head;
+    Index m_tail;
+};
+
+template<typename Type>
+CompactList<Type>::CompactList()
+    : m_slots(nullptr), m_capacity(0), m_size(0), m_end(0), m_free(npos), m_head(npos), m_tail(npos) {}
+
+template<typename Type>
+CompactList<Type>::CompactList(Type values[], size_t size) : CompactList() {
+    reserve(size);
+    for (size_t i = 0; i < size; i++) {
+        insert(values[i]);
+    }
+}
+
+template<typename Type>
+CompactList<Type>::CompactList(std::initializer_list<Type> values) : CompactList() {
+    reserve(values.size());
+    for (Type val : values) {
+        insert(val);
+    }
+}
+
+template<typename Type>
+CompactList<Type>::CompactList(const CompactList<Type>& list) : CompactList() {
+    copyFrom(list);
+}
+
+template<typename Type>
+CompactList<Type>::CompactList(CompactList<Type>&& list) noexcept
+    : m_slots(std::move(list.m_slots)), m_capacity(list.m_capacity), m_size(list.m_size), m_end(list.m_end),
+      m_free(list.m_free), m_head(list.m_head), m_tail(list.m_tail) {
+    list.m_capacity = list.m_size = 0;
+    list.m_end = 0;
+    list.m_free = list.m_head = list.m_tail = npos;
+}
+
+template<typename Type>
+CompactList<Type>& CompactList<Type>::operator=(const CompactList<Type>& list) {
+    if (this != &list) {
+        copyFrom(list);
+    }
+    return *this;
+}
+
+template<typename Type>
+CompactList<Type>& CompactList<Type>::operator=(CompactList<Type>&& list) noexcept {
+    if (this != &list) {
+        m_slots = std::move(list.m_slots);
+        m_capacity = list.m_capacity;
+        m_size = list.m_size;
+        m_end = list.m_end;
+        m_free = list.m_free;
+        m_head = list.m_head;
+        m_tail = list.m_tail;
+        list.m_capacity = list.m_size = 0;
+        list.m_end = 0;
+        list.m_free = list.m_head = list.m_tail = npos;
+    }
+    return *this;
+}
+
+template<typename Type>
+void CompactList<Type>::copyFrom(const CompactList<Type>& list) {
+    clear();
+    reserve(list.m_size);
+    for (Index node = list.m_head; node != npos; node = list.m_slots[node].next) {
+        insert(list.m_slots[node].value);
+    }
+}
+
+template<typename Type>
+void CompactList<Type>::grow(size_t capacity) {
+    if (capacity > npos) {
+#ifdef _DEBUG
+        throw std::length_error("CompactList cannot hold more than 2^32 - 1 nodes.");
+#endif
+        capacity = npos;
+    }
+    // Copy the unused tail as well, it may carry generations from before compact()
+    std::unique_ptr<Slot[]> slots = std::make_unique<Slot[]>(capacity);
+    for (size_t i = 0; i < m_capacity; i++) {
+        slots[i] = std::move(m_slots[i]);
+    }
+    m_slots = std::move(slots);
+    m_capacity = capacity;
+}
+
+template<typename Type>
+void CompactList<Type>::reserve(size_t count) {
+    if (count > m_capacity) {
+        grow(count);
+    }
+}
+
+template<typename Type>
+typename CompactList<Type>::Index CompactList<Type>::allocate(Type value) {
+    Index node;
+    if (m_free != npos) {
+        node = m_free;
+        m_free = m_slots[node].next;
+    } else {
+        if (m_end == m_capacity) {
+            grow(m_capacity < 8 ? 8 : m_capacity * 2);
+        }
+        node = m_end++;
+    }
+    m_slots[node].value = value;
+    m_slots[node].next = npos;
+    m_slots[node].prev = npos;
+    m_slots[node].generation++;
+    m_size++;
+    return node;
+}
+
+template<typename Type>
+typename CompactList<Type>::Index CompactList<Type>::insert(Type value) {
+    if (m_tail == npos) {
+        m_head = m_tail = allocate(value);
+        return m_head;
+    }
+    return insertAfter(m_tail, value);
+}
+
+template<typename Type>
+typename CompactList<Type>::Index CompactList<Type>::unshift(Type value) {
+    if (m_head == npos) {
+        m_head = m_tail = allocate(value);
+        return m_head;
+    }
+    return insertBefore(m_head, value);
+}
+
+template<typename Type>
+typename CompactList<Type>::Index CompactList<Type>::insertBefore(Index node, Type value) {
+    if (node == npos) {
+#ifdef _DEBUG
+        throw std::invalid_argument("Cannot insert before node as CompactList is empty");
+#endif
+        return npos;
+    }
+    Index newNode = allocate(value);
+    Index prev = m_slots[node].prev;
+    m_slots[newNode].next = node;
+    m_slots[newNode].prev = prev;
+    m_slots[node].prev = newNode;
+    if (prev == npos) {
+        m_head = newNode;
+    } else {
+        m_slots[prev].next = newNode;
+    }
+    return newNode;
+}
+
+template<typename Type>
+typename CompactList<Type>::Index CompactList<Type>::insertAfter(Index node, Type value) {
+    if (node == npos) {
+#ifdef _DEBUG
+        throw std::invalid_argument("Cannot insert after node as CompactList is empty");
+#endif
+        return npos;
+    }
+    Index newNode = allocate(value);
+    Index next = m_slots[node].next;
+    m_slots[newNode].prev = node;
+    m_slots[newNode].next = next;
+    m_slots[node].next = newNode;
+    if (next == npos) {
+        m_tail = newNode;
+    } else {
+        m_slots[next].prev = newNode;
+    }
+    return newNode;
+}
+
+template<typename Type>
+typename CompactList<Type>::Index CompactList<Type>::priorityInsert(Type value) {
+    Index node = m_head;
+    while (node != npos && m_slots[node].value < value) {
+        node = m_slots[node].next;
+    }
+    if (node == npos) {
+        return insert(value);
+    }
+    return insertBefore(node, value);
+}
+
+template<typename Type>
+Type CompactList<Type>::getHead() const {
+    if (m_head == npos) {
+#ifdef _DEBUG
+        throw std::out_of_range("Cannot get head as CompactList is empty.");
+#endif
+        return Type();
+    }
+    return m_slots[m_head].value;
+}
+
+template<typename Type>
+Type CompactList<Type>::getTail() const {
+    if (m_tail == npos) {
+#ifdef _DEBUG
+        throw std::out_of_range("Cannot get tail as CompactList is empty.");
+#endif
+        return Type();
+    }
+    return m_slots[m_tail].value;
+}
+
+template<typename Type>
+bool CompactList<Type>::removeHead() {
+    if (m_head == npos) {
+#ifdef _DEBUG
+        throw std::out_of_range("Cannot remove head as CompactList is empty.");
+#endif
+        return false;
+    }
+    return remove(m_head);
+}
+
+template<typename Type>
+bool CompactList<Type>::removeTail() {
+    if (m_tail == npos) {
+#ifdef _DEBUG
+        throw std::out_of_range("Cannot remove tail as CompactList is empty.");
+#endif
+        return false;
+    }
+    return remove(m_tail);
+}
+
+template<typename Type>
+bool CompactList<Type>::remove(Index node) {
+    if (node == npos || node >= m_end || (m_slots[node].generation & 1) == 0) {
+#ifdef _DEBUG
+        throw std::out_of_range("CompactList slot index out of bounds.");
+#endif
+        return false;
+    }
+    Index prev = m_slots[node].prev;
+    Index next = m_slots[node].next;
+    if (prev == npos) {
+        m_head = next;
+    } else {
+        m_slots[prev].next = next;
+    }
+    if (next == npos) {
+        m_tail = prev;
+    } else {
+        m_slots[next].prev = prev;
+    }
+    m_slots[node].value = Type();
+    m_slots[node].generation++;
+    m_slots[node].prev = npos;
+    m_slots[node].next = m_free;
+    m_free = node;
+    m_size--;
+    return true;
+}
+
+template<typename Type>
+bool CompactList<Type>::remove(Type value) {
+    for (Index node = m_head; node != npos; node = m_slots[node].next) {
+        if (m_slots[node].value == value) {
+            return remove(node);
+        }
+    }
+    return false;
+}
+
+template<typename Type>
+bool CompactList<Type>::valid(Handle node) const {
+    return node.index < m_end && m_slots[node.index].generation == node.generation && (node.generation & 1) == 1;
+}
+
+template<typename Type>
+Type* CompactList<Type>::get(Handle node) const {
+    return valid(node) ? &m_slots[node.index].value : nullptr;
+}
+
+template<typename Type>
+typename CompactList<Type>::Handle CompactList<Type>::insertBefore(Handle node, Type value) {
+    if (!valid(node)) {
+#ifdef _DEBUG
+        throw std::invalid_argument("Cannot insert before a removed CompactList node");
+#endif
+        return Handle();
+    }
+    return handle(insertBefore(node.index, value));
+}
+
+template<typename Type>
+typename CompactList<Type>::Handle CompactList<Type>::insertAfter(Handle node, Type value) {
+    if (!valid(node)) {
+#ifdef _DEBUG
+        throw std::invalid_argument("Cannot insert after a removed CompactList node");
+#endif
+        return Handle();
+    }
+    return handle(insertAfter(node.index, value));
+}
+
+template<typename Type>
+bool CompactList<Type>::remove(Handle node) {
+    if (!valid(node)) {
+        return false;
+    }
+    return remove(node.index);
+}
+
+template<typename Type>
+void CompactList<Type>::compact() {
+    // Start every slot past the newest generation so no earlier handle matches. Scan the
+    // whole arena: slots above m_end still carry the floor set by an earlier compact().
+    uint32_t generation = 0;
+    for (size_t i = 0; i < m_capacity; i++) {
+        if (m_slots[i].generation > generation) {
+            generation = m_slots[i].generation;
+        }
+    }
+    generation = (generation | 1) + 1;
+
+    std::unique_ptr<Slot[]> slots = std::make_unique<Slot[]>(m_capacity);
+    Index pos = 0;
+    for (Index node = m_head; node != npos; node = m_slots[node].next) {
+        slots[pos].value = std::move(m_slots[node].value);
+        slots[pos].prev = (pos == 0) ? npos : pos - 1;
+        slots[pos].next = pos + 1;
+        slots[pos].generation = generation + 1;
+        pos++;
+    }
+    for (size_t i = pos; i < m_capacity; i++) {
+        slots[i].generation = generation;
+    }
+    m_slots = std::move(slots);
+    m_end = pos;
+    m_free = npos;
+    if (pos == 0) {
+        m_head = m_tail = npos;
+        return;
+    }
+    m_slots[pos - 1].next = npos;
+    m_head = 0;
+    m_tail = pos - 1;
+}
+
+template<typename Type>
+void CompactList<Type>::clear() {
+    // Release the slots rather than forgetting them so outstanding handles stay stale
+    Index node = m_head;
+    while (node != npos) {
+        Index next = m_slots[node].next;
+        m_slots[node].value = Type();
+        m_slots[node].generation++;
+        m_slots[node].prev = npos;
+        m_slots[node].next = m_free;
+        m_free = node;
+        node = next;
+    }
+    m_size = 0;
+    m_head = npos;
+    m_tail = npos;
+}
+
+#endif
@@ -0,0 +1,349 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_DARY_HEAP_H
+#define DS_DARY_HEAP_H
+
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#if defined(__SSE4_1__) || defined(__AVX__)
+#include <smmintrin.h>
+#define DS_DARY_HEAP_SIMD
+#endif
+
+/* Priority queue as a d-ary heap with the arity fixed at compile time.
+ * A wider heap is shallower, so sift-down touches fewer levels, and the children of
+ * a node are adjacent. Storage is aligned to a cache line and the root is shifted by
+ * Arity - 1 slots so every group of siblings starts on a multiple of Arity: with
+ * 4 byte keys, Arity 4 puts the siblings in a quarter line and Arity 16 fills one,
+ * and with 8 byte keys Arity 8 fills one. For int32_t, uint32_t and float keys ordered
+ * by std::less or std::greater the best child is picked with SSE4.1 when the target
+ * has it. Like std::priority_queue, Compare = std::less puts the largest value on top. */
+template<typename Type, size_t Arity = 4, typename Compare = std::less<Type>>
+class DaryHeap
+{
+    static_assert(Arity >= 2, "DaryHeap needs an arity of at least 2");
+
+  public:
+    DaryHeap(const Compare& compare = Compare());
+    DaryHeap(Type values[], size_t size, const Compare& compare = Compare());
+    DaryHeap(std::initializer_list<Type> values, const Compare& compare = Compare());
+    DaryHeap(const DaryHeap& heap) = delete;
+    DaryHeap(DaryHeap&& heap) noexcept;
+    ~DaryHeap();
+
+    DaryHeap& operator=(const DaryHeap& heap) = delete;
+    DaryHeap& operator=(DaryHeap&& heap) noexcept;
+
+    // front() is the element pop() returns next
+    Type front() const;
+
+    inline bool empty() const { return (m_size == 0); }
+    inline size_t size() const { return m_size; }
+    inline size_t capacity() const { return m_capacity; }
+
+    void push(const Type value);
+
+    // Push count values, heapifying bottom-up in O(n) when the range is at least as large as the heap
+    void push_range(const Type* values, size_t count);
+
+    Type pop();
+    void clear();
+
+    // Make room for count elements without growing
+    void reserve(size_t count);
+
+  private:
+    static constexpr size_t cacheLine = 64;
+    static constexpr size_t offset = Arity - 1;
+
+    struct alignas(cacheLine) Line
+    {
+        unsigned char bytes[cacheLine];
+    };
+
+    // Element pos of the heap, shifted so sibling groups are aligned
+    inline Type* slot(size_t pos) const { return reinterpret_cast<Type*>(m_lines.get()) + offset + pos; }
+
+    // Heap position of the child of the first count children that goes up first
+    size_t bestChild(size_t first, size_t count) const;
+
+#ifdef DS_DARY_HEAP_SIMD
+    // Offset of the best of Arity keys, or Arity if SIMD does not apply
+    static size_t bestChildSimd(const Type* children);
+#endif
+
+    void grow(size_t capacity);
+    void siftUp(size_t pos);
+    void siftDown(size_t pos);
+
+    std::unique_ptr<Line[]> m_lines;
+    size_t m_capacity;
+    size_t m_size;
+    Compare m_compare;
+};
+
+template<typename Type, typename Compare = std::less<Type>>
+using QuaternaryHeap = DaryHeap<Type, 4, Compare>;
+
+template<typename Type, typename Compare = std::less<Type>>
+using OctonaryHeap = DaryHeap<Type, 8, Compare>;
+
+template<typename Type, size_t Arity, typename Compare>
+DaryHeap<Type, Arity, Compare>::DaryHeap(const Compare& compare)
+    : m_lines(nullptr), m_capacity(0), m_size(0), m_compare(compare) {}
+
+template<typename Type, size_t Arity, typename Compare>
+DaryHeap<Type, Arity, Compare>::DaryHeap(Type values[], size_t size, const Compare& compare) : DaryHeap(compare) {
+    push_range(values, size);
+}
+
+template<typename Type, size_t Arity, typename Compare>
+DaryHeap<Type, Arity, Compare>::DaryHeap(std::initializer_list<Type> values, const Compare& compare)
+    : DaryHeap(compare) {
+    push_range(values.begin(), values.size());
+}
+
+template<typename Type, size_t Arity, typename Compare>
+DaryHeap<Type, Arity, Compare>::DaryHeap(DaryHeap&& heap) noexcept
+    : m_lines(std::move(heap.m_lines)), m_capacity(heap.m_capacity), m_size(heap.m_size),
+      m_compare(std::move(heap.m_compare)) {
+    heap.m_capacity = heap.m_size = 0;
+}
+
+template<typename Type, size_t Arity, typename Compare>
+DaryHeap<Type, Arity, Compare>::~DaryHeap() {
+    clear();
+}
+
+template<typename Type, size_t Arity, typename Compare>
+DaryHeap<Type, Arity, Compare>& DaryHeap<Type, Arity, Compare>::operator=(DaryHeap&& heap) noexcept {
+    if (this != &heap) {
+        clear();
+        m_lines = std::move(heap.m_lines);
+        m_capacity = heap.m_capacity;
+        m_size = heap.m_size;
+        m_compare = std::move(heap.m_compare);
+        heap.m_capacity = heap.m_size = 0;
+    }
+    return *this;
+}
+
+template<typename Type, size_t Arity, typename Compare>
+void DaryHeap<Type, Arity, Compare>::grow(size_t capacity) {
+    size_t lines = ((offset + capacity) * sizeof(Type) + cacheLine - 1) / cacheLine;
+    std::unique_ptr<Line[]> grown(new Line[lines]);
+    Type* data = reinterpret_cast<Type*>(grown.get()) + offset;
+    for (size_t i = 0; i < m_size; i++) {
+        new (data + i) Type(std::move(*slot(i)));
+        slot(i)->~Type();
+    }
+    m_lines = std::move(grown);
+    m_capacity = capacity;
+}
+
+template<typename Type, size_t Arity, typename Compare>
+void DaryHeap<Type, Arity, Compare>::reserve(size_t count) {
+    if (count > m_capacity) {
+        grow(count);
+    }
+}
+
+#ifdef DS_DARY_HEAP_SIMD
+template<typename Type, size_t Arity, typename Compare>
+size_t DaryHeap<Type, Arity, Compare>::bestChildSimd(const Type* children) {
+    constexpr bool isMax = std::is_same<Compare, std::less<Type>>::value;
+    constexpr bool isMin = std::is_same<Compare, std::greater<Type>>::value;
+    constexpr bool isInt = std::is_same<Type, int32_t>::value;
+    constexpr bool isUnsigned = std::is_same<Type, uint32_t>::value;
+    constexpr bool isFloat = std::is_same<Type, float>::value;
+    if constexpr ((isMax || isMin) && (isInt || isUnsigned || isFloat) && Arity % 4 == 0) {
+        // Reduce all groups of four to the best value in every lane, then find its first lane
+        auto best = [](__m128 a, __m128 b) {
+            if constexpr (isFloat) {
+                return isMax ? _mm_max_ps(a, b) : _mm_min_ps(a, b);
+            } else if constexpr (isInt) {
+                __m128i x = _mm_castps_si128(a), y = _mm_castps_si128(b);
+                return _mm_castsi128_ps(isMax ? _mm_max_epi32(x, y) : _mm_min_epi32(x, y));
+            } else {
+                __m128i x = _mm_castps_si128(a), y = _mm_castps_si128(b);
+                return _mm_castsi128_ps(isMax ? _mm_max_epu32(x, y) : _mm_min_epu32(x, y));
+            }
+        };
+        auto equal = [](__m128 a, __m128 b) {
+            if constexpr (isFloat) {
+                return _mm_movemask_ps(_mm_cmpeq_ps(a, b));
+            } else {
+                return _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_castps_si128(a), _mm_castps_si128(b))));
+            }
+        };
+        const float* lanes = reinterpret_cast<const float*>(children);
+        __m128 reduced = _mm_loadu_ps(lanes);
+        for (size_t i = 4; i < Arity; i += 4) {
+            reduced = best(reduced, _mm_loadu_ps(lanes + i));
+        }
+        reduced = best(reduced, _mm_shuffle_ps(reduced, reduced, _MM_SHUFFLE(1, 0, 3, 2)));
+        reduced = best(reduced, _mm_shuffle_ps(reduced, reduced, _MM_SHUFFLE(2, 3, 0, 1)));
+        for (size_t i = 0; i < Arity; i += 4) {
+            int mask = equal(_mm_loadu_ps(lanes + i), reduced);
+            if (mask != 0) {
+                return i + ((mask & 1) ? 0 : (mask & 2) ? 1 : (mask & 4) ? 2 : 3);
+            }
+        }
+        // Only NaN keys get here
+    }
+    (void)children;
+    return Arity;
+}
+#endif
+
+template<typename Type, size_t Arity, typename Compare>
+size_t DaryHeap<Type, Arity, Compare>::bestChild(size_t first, size_t count) const {
+    const Type* children = slot(first);
+#ifdef DS_DARY_HEAP_SIMD
+    if (count == Arity) {
+        size_t best = bestChildSimd(children);
+        if (best != Arity) {
+            return first + best;
+        }
+    }
+#endif
+    size_t best = 0;
+    for (size_t i = 1; i < count; i++) {
+        if (m_compare(children[best], children[i])) {
+            best = i;
+        }
+    }
+    return first + best;
+}
+
+template<typename Type, size_t Arity, typename Compare>
+void DaryHeap<Type, Arity, Compare>::siftUp(size_t pos) {
+    Type value = std::move(*slot(pos));
+    while (pos > 0) {
+        size_t parent = (pos - 1) / Arity;
+        if (!m_compare(*slot(parent), value)) {
+            break;
+        }
+        *slot(pos) = std::move(*slot(parent));
+        pos = parent;
+    }
+    *slot(pos) = std::move(value);
+}
+
+template<typename Type, size_t Arity, typename Compare>
+void DaryHeap<Type, Arity, Compare>::siftDown(size_t pos) {
+    Type value = std::move(*slot(pos));
+    size_t first = Arity * pos + 1;
+    while (first < m_size) {
+        size_t child = bestChild(first, (m_size - first < Arity) ? m_size - first : Arity);
+        if (!m_compare(value, *slot(child))) {
+            break;
+        }
+        *slot(pos) = std::move(*slot(child));
+        pos = child;
+        first = Arity * pos + 1;
+    }
+    *slot(pos) = std::move(value);
+}
+
+template<typename Type, size_t Arity, typename Compare>
+void DaryHeap<Type, Arity, Compare>::push(const Type value) {
+    if (m_size == m_capacity) {
+        grow(m_capacity < 16 ? 16 : m_capacity * 2);
+    }
+    new (slot(m_size)) Type(value);
+    siftUp(m_size++);
+}
+
+template<typename Type, size_t Arity, typename Compare>
+void DaryHeap<Type, Arity, Compare>::push_range(const Type* values, size_t count) {
+    if (m_size + count > m_capacity) {
+        size_t capacity = m_capacity < 16 ? 16 : m_capacity * 2;
+        grow(capacity < m_size + count ? m_size + count : capacity);
+    }
+    size_t first = m_size;
+    for (size_t i = 0; i < count; i++) {
+        new (slot(m_size++)) Type(values[i]);
+    }
+    if (count < first) {
+        for (size_t i = first; i < m_size; i++) {
+            siftUp(i);
+        }
+    } else if (m_size > 1) {
+        // Sift down every parent from the last one up
+        for (size_t i = (m_size - 2) / Arity + 1; i-- > 0;) {
+            siftDown(i);
+        }
+    }
+}
+
+template<typename Type, size_t Arity, typename Compare>
+Type DaryHeap<Type, Arity, Compare>::front() const {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("DaryHeap is empty.");
+#endif// _DEBUG
+        return Type();
+    }
+    return *slot(0);
+}
+
+template<typename Type, size_t Arity, typename Compare>
+Type DaryHeap<Type, Arity, Compare>::pop() {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("DaryHeap is empty.");
+#endif// _DEBUG
+        return Type();
+    }
+    Type returnValue = std::move(*slot(0));
+    m_size--;
+    if (m_size > 0) {
+        *slot(0) = std::move(*slot(m_size));
+    }
+    slot(m_size)->~Type();
+    if (m_size > 1) {
+        siftDown(0);
+    }
+    return returnValue;
+}
+
+template<typename Type, size_t Arity, typename Compare>
+void DaryHeap<Type, Arity, Compare>::clear() {
+    for (size_t i = 0; i < m_size; i++) {
+        slot(i)->~Type();
+    }
+    m_size = 0;
+}
+
+#endif
@@ -27,33 +27,317 @@
 #ifndef DS_DEQUE_H
 #define DS_DEQUE_H
 
+#include <cstddef>
+#include <cstring>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
 #include <stdexcept>
-#include "DoublyLinkedList.h"
+#include <type_traits>
+#include <utility>
 
+/* Double ended queue as a growable power-of-two ring buffer.
+ * head and tail run freely and are masked into the buffer, so both ends grow and
+ * shrink in amortized O(1) without a per-element allocation, and operator[] is O(1). */
 template<typename Type>
 class Deque
 {
   public:
-    Deque() { m_list.clear(); }
-    Deque(Type values[], size_t size) : m_list(values, size) {}
-    Deque(std::initializer_list<Type> values) : m_list(values) {}
-    ~Deque() { m_list.clear(); }
+    template<bool Const>
+    class BasicIterator;
+    typedef BasicIterator<false> Iterator;
+    typedef BasicIterator<true> ConstIterator;
 
-    inline Type front() const { return m_list.getHead(); }
-    inline Type back() const { return m_list.getTail(); }
-    inline bool empty() const { return m_list.empty(); }
+    Deque();
+    Deque(Type values[], size_t size);
+    Deque(std::initializer_list<Type> values);
+    Deque(const Deque<Type>& deque);
+    Deque(Deque<Type>&& deque) noexcept;
+    ~Deque() { clear(); }
 
-    void push_back(const Type value) { m_list.insert(value); }
-    void push_front(const Type value) { m_list.unshift(value); }
+    Deque<Type>& operator=(const Deque<Type>& deque);
+    Deque<Type>& operator=(Deque<Type>&& deque) noexcept;
+
+    Type front() const;
+    Type back() const;
+    inline bool empty() const { return (m_head == m_tail); }
+    inline size_t size() const { return (m_tail - m_head); }
+    inline size_t capacity() const { return m_mask + 1; }
+
+    // Element pos places from the front. Only checked in debug builds, where an
+    // out of range pos throws; otherwise pos has to be below size().
+    Type& at(size_t pos);
+    const Type& at(size_t pos) const;
+    inline Type& operator[](size_t pos) { return m_data[(m_head + pos) & m_mask]; }
+    inline const Type& operator[](size_t pos) const { return m_data[(m_head + pos) & m_mask]; }
+
+    Iterator begin() { return Iterator(this, 0); }
+    Iterator end() { return Iterator(this, size()); }
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end() const { return ConstIterator(this, size()); }
+
+    void push_back(const Type value);
+    void push_front(const Type value);
     Type pop_back();
     Type pop_front();
-    void clear() { m_list.clear(); }
+    void clear() { m_head = m_tail = 0; }
+
+    // Make room for count elements without growing
+    void reserve(size_t count);
+
+    // Append count values in order
+    void push_back_range(const Type* values, size_t count);
+
+    // Prepend count values in order, values[0] becomes the front
+    void push_front_range(const Type* values, size_t count);
+
+    // Pop up to count values from the front into out, in deque order. Returns the number popped.
+    size_t pop_front_range(Type* out, size_t count);
+
+    // Pop up to count values from the back into out, in deque order. Returns the number popped.
+    size_t pop_back_range(Type* out, size_t count);
 
   private:
-    DoublyLinkedList<Type> m_list;
+    // Copy with memcpy when Type allows it
+    static void copy(Type* dest, const Type* src, size_t count);
+
+    // Copy count values into the ring starting at the free-running position pos
+    void copyIn(size_t pos, const Type* values, size_t count);
+
+    // Copy count values out of the ring starting at the free-running position pos
+    void copyOut(size_t pos, Type* out, size_t count) const;
+
+    std::unique_ptr<Type[]> m_data;
+    size_t m_mask;
+    size_t m_head;
+    size_t m_tail;
 };
 
+template<typename Type>
+template<bool Const>
+class Deque<Type>::BasicIterator
+{
+    typedef typename std::conditional<Const, const Deque<Type>, Deque<Type>>::type Container;
+
+  public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef Type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::conditional<Const, const Type*, Type*>::type pointer;
+    typedef typename std::conditional<Const, const Type&, Type&>::type reference;
+
+    BasicIterator() : m_deque(nullptr), m_pos(0) {}
+    BasicIterator(Container* deque, size_t pos) : m_deque(deque), m_pos(pos) {}
+
+    // A mutable iterator converts to a const one
+    template<bool Other, typename = typename std::enable_if<Const && !Other>::type>
+    BasicIterator(const BasicIterator<Other>& it) : m_deque(it.m_deque), m_pos(it.m_pos) {}
+
+    inline reference operator*() const { return (*m_deque)[m_pos]; }
+    inline pointer operator->() const { return &(*m_deque)[m_pos]; }
+    inline reference operator[](difference_type n) const { return (*m_deque)[m_pos + n]; }
+
+    inline BasicIterator& operator++() {
+        m_pos++;
+        return *this;
+    }
+    inline BasicIterator operator++(int) { return BasicIterator(m_deque, m_pos++); }
+    inline BasicIterator& operator--() {
+        m_pos--;
+        return *this;
+    }
+    inline BasicIterator operator--(int) { return BasicIterator(m_deque, m_pos--); }
+    inline BasicIterator& operator+=(difference_type n) {
+        m_pos += n;
+        return *this;
+    }
+    inline BasicIterator& operator-=(difference_type n) {
+        m_pos -= n;
+        return *this;
+    }
+    inline BasicIterator operator+(difference_type n) const { return BasicIterator(m_deque, m_pos + n); }
+    inline BasicIterator operator-(difference_type n) const { return BasicIterator(m_deque, m_pos - n); }
+    inline difference_type operator-(const BasicIterator& it) const { return static_cast<difference_type>(m_pos - it.m_pos); }
+
+    inline bool operator==(const BasicIterator& it) const { return m_pos == it.m_pos; }
+    inline bool operator!=(const BasicIterator& it) const { return m_pos != it.m_pos; }
+    inline bool operator<(const BasicIterator& it) const { return m_pos < it.m_pos; }
+    inline bool operator>(const BasicIterator& it) const { return m_pos > it.m_pos; }
+    inline bool operator<=(const BasicIterator& it) const { return m_pos <= it.m_pos; }
+    inline bool operator>=(const BasicIterator& it) const { return m_pos >= it.m_pos; }
+
+  private:
+    Container* m_deque;
+    size_t m_pos;
+
+    template<bool Other>
+    friend class BasicIterator;
+};
+
+template<typename Type>
+Deque<Type>::Deque() : m_data(nullptr), m_mask(size_t(-1)), m_head(0), m_tail(0) {}
+
+template<typename Type>
+Deque<Type>::Deque(Type values[], size_t size) : Deque() {
+    push_back_range(values, size);
+}
+
+template<typename Type>
+Deque<Type>::Deque(std::initializer_list<Type> values) : Deque() {
+    push_back_range(values.begin(), values.size());
+}
+
+template<typename Type>
+Deque<Type>::Deque(const Deque<Type>& deque) : Deque() {
+    reserve(deque.size());
+    deque.copyOut(deque.m_head, m_data.get(), deque.size());
+    m_tail = deque.size();
+}
+
+template<typename Type>
+Deque<Type>::Deque(Deque<Type>&& deque) noexcept
+    : m_data(std::move(deque.m_data)), m_mask(deque.m_mask), m_head(deque.m_head), m_tail(deque.m_tail) {
+    deque.m_mask = size_t(-1);
+    deque.m_head = deque.m_tail = 0;
+}
+
+template<typename Type>
+Deque<Type>& Deque<Type>::operator=(const Deque<Type>& deque) {
+    if (this != &deque) {
+        clear();
+        reserve(deque.size());
+        deque.copyOut(deque.m_head, m_data.get(), deque.size());
+        m_tail = deque.size();
+    }
+    return *this;
+}
+
+template<typename Type>
+Deque<Type>& Deque<Type>::operator=(Deque<Type>&& deque) noexcept {
+    if (this != &deque) {
+        m_data = std::move(deque.m_data);
+        m_mask = deque.m_mask;
+        m_head = deque.m_head;
+        m_tail = deque.m_tail;
+        deque.m_mask = size_t(-1);
+        deque.m_head = deque.m_tail = 0;
+    }
+    return *this;
+}
+
+template<typename Type>
+void Deque<Type>::copy(Type* dest, const Type* src, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    if (std::is_trivially_copyable<Type>::value) {
+        std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(Type));
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            dest[i] = src[i];
+        }
+    }
+}
+
+template<typename Type>
+void Deque<Type>::copyIn(size_t pos, const Type* values, size_t count) {
+    size_t start = pos & m_mask;
+    size_t first = (count < capacity() - start) ? count : capacity() - start;
+    copy(m_data.get() + start, values, first);
+    copy(m_data.get(), values + first, count - first);
+}
+
+template<typename Type>
+void Deque<Type>::copyOut(size_t pos, Type* out, size_t count) const {
+    if (count == 0) {
+        return;
+    }
+    size_t start = pos & m_mask;
+    size_t first = (count < capacity() - start) ? count : capacity() - start;
+    copy(out, m_data.get() + start, first);
+    copy(out + first, m_data.get(), count - first);
+}
+
+template<typename Type>
+void Deque<Type>::reserve(size_t count) {
+    if (m_data != nullptr && count <= capacity()) {
+        return;
+    }
+    size_t capacity = 8;
+    while (capacity < count) {
+        capacity *= 2;
+    }
+    std::unique_ptr<Type[]> data = std::make_unique<Type[]>(capacity);
+    size_t elements = size();
+    if (m_data != nullptr) {
+        copyOut(m_head, data.get(), elements);
+    }
+    m_data = std::move(data);
+    m_mask = capacity - 1;
+    m_head = 0;
+    m_tail = elements;
+}
+
+template<typename Type>
+Type Deque<Type>::front() const {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("Deque is empty");
+#endif// _DEBUG
+        return Type();
+    }
+    return m_data[m_head & m_mask];
+}
+
+template<typename Type>
+Type Deque<Type>::back() const {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("Deque is empty");
+#endif// _DEBUG
+        return Type();
+    }
+    return m_data[(m_tail - 1) & m_mask];
+}
+
+template<typename Type>
+Type& Deque<Type>::at(size_t pos) {
+    if (pos >= size()) {
+#ifdef _DEBUG
+        throw std::out_of_range("Deque index out of bounds");
+#endif// _DEBUG
+    }
+    return (*this)[pos];
+}
+
+template<typename Type>
+const Type& Deque<Type>::at(size_t pos) const {
+    if (pos >= size()) {
+#ifdef _DEBUG
+        throw std::out_of_range("Deque index out of bounds");
+#endif// _DEBUG
+    }
+    return (*this)[pos];
+}
+
+template<typename Type>
+void Deque<Type>::push_back(const Type value) {
+    if (m_data == nullptr || size() == capacity()) {
+        reserve(size() + 1);
+    }
+    m_data[m_tail & m_mask] = value;
+    m_tail++;
+}
+
+template<typename Type>
+void Deque<Type>::push_front(const Type value) {
+    if (m_data == nullptr || size() == capacity()) {
+        reserve(size() + 1);
+    }
+    m_head--;
+    m_data[m_head & m_mask] = value;
+}
+
 template<typename Type>
 inline Type Deque<Type>::pop_back() {
     if (empty()) {
@@ -62,9 +346,8 @@ inline Type Deque<Type>::pop_back() {
 #endif// _DEBUG
         return Type();
     }
-    Type value = m_list.getTail();
-    m_list.removeTail();
-    return value;
+    m_tail--;
+    return std::move(m_data[m_tail & m_mask]);
 }
 
 template<typename Type>
@@ -75,9 +358,42 @@ Type Deque<Type>::pop_front() {
 #endif// _DEBUG
         return Type();
     }
-    Type value = m_list.getHead();
-    m_list.removeHead();
-    return value;
+    m_head++;
+    return std::move(m_data[(m_head - 1) & m_mask]);
+}
+
+template<typename Type>
+void Deque<Type>::push_back_range(const Type* values, size_t count) {
+    reserve(size() + count);
+    copyIn(m_tail, values, count);
+    m_tail += count;
+}
+
+template<typename Type>
+void Deque<Type>::push_front_range(const Type* values, size_t count) {
+    reserve(size() + count);
+    m_head -= count;
+    copyIn(m_head, values, count);
+}
+
+template<typename Type>
+size_t Deque<Type>::pop_front_range(Type* out, size_t count) {
+    if (count > size()) {
+        count = size();
+    }
+    copyOut(m_head, out, count);
+    m_head += count;
+    return count;
+}
+
+template<typename Type>
+size_t Deque<Type>::pop_back_range(Type* out, size_t count) {
+    if (count > size()) {
+        count = size();
+    }
+    m_tail -= count;
+    copyOut(m_tail, out, count);
+    return count;
 }
 
 #endif
@@ -45,10 +45,16 @@ class DoublyLinkedList
     inline Node* head() const { return m_head; }
     inline Node* tail() const { return m_tail; }
 
-    void insert(Type value);
-    void unshift(Type value);
-    void insertBefore(Node* node, Type value);
-    void insertAfter(Node* node, Type value);
+    // The insert functions return the newly created node
+    Node* insert(Type value);
+    Node* unshift(Type value);
+    Node* insertBefore(Node* node, Type value);
+    Node* insertAfter(Node* node, Type value);
+
+    // Relink an existing node without reallocating it
+    void moveToHead(Node* node);
+    void moveToTail(Node* node);
+    void moveAfter(Node* node, Node* pos);
 
     // Inserts a value such that the list is in ascending order
     void priorityInsert(Type value);
@@ -64,6 +70,12 @@ class DoublyLinkedList
     void clear();
 
   private:
+    // Detach node from its neighbours, keeping the node alive
+    void unlink(Node* node);
+
+    // Attach a detached node after pos, or at the head when pos is nullptr
+    void linkAfter(Node* node, Node* pos);
+
     Node* m_head;
     Node* m_tail;
 };
@@ -98,66 +110,108 @@ DoublyLinkedList<Type>::DoublyLinkedList(std::initializer_list<Type> values) : m
 }
 
 template<typename Type>
-void DoublyLinkedList<Type>::insert(Type value) {
+typename DoublyLinkedList<Type>::Node* DoublyLinkedList<Type>::insert(Type value) {
     if (m_tail == nullptr) {
         m_head = new Node(value);
         m_tail = m_head;
-        return;
+        return m_head;
     }
-    insertAfter(m_tail, value);
+    return insertAfter(m_tail, value);
 }
 
 template<typename Type>
-void DoublyLinkedList<Type>::unshift(Type value) {
+typename DoublyLinkedList<Type>::Node* DoublyLinkedList<Type>::unshift(Type value) {
     if (m_head == nullptr) {
         m_tail = new Node(value);
         m_head = m_tail;
-        return;
+        return m_head;
     }
-    insertBefore(m_head, value);
+    return insertBefore(m_head, value);
 }
 
-
 template<typename Type>
-void DoublyLinkedList<Type>::insertBefore(Node* node, Type value) {
-    Node* newNode = new Node(value);
+typename DoublyLinkedList<Type>::Node* DoublyLinkedList<Type>::insertBefore(Node* node, Type value) {
     if (node == nullptr) {
 #ifdef _DEBUG
         throw std::invalid_argument("Cannot insert before node as DoublyLinkedList is empty");
 #endif
-        return;
-    }
-    if (node->prev == nullptr) {
-        newNode->next = m_head;
-        m_head->prev = newNode;
-        m_head = newNode;
-        return;
+        return nullptr;
     }
-    newNode->prev = node->prev;
-    node->prev = newNode;
-    newNode->prev = node;
-    newNode->prev->next = newNode;
+    Node* newNode = new Node(value);
+    linkAfter(newNode, node->prev);
+    return newNode;
 }
 
 template<typename Type>
-void DoublyLinkedList<Type>::insertAfter(Node* node, Type value) {
-    Node* newNode = new Node(value);
+typename DoublyLinkedList<Type>::Node* DoublyLinkedList<Type>::insertAfter(Node* node, Type value) {
     if (node == nullptr) {
 #ifdef _DEBUG
         throw std::invalid_argument("Cannot insert after node as DoublyLinkedList is empty");
 #endif
-        return;
+        return nullptr;
+    }
+    Node* newNode = new Node(value);
+    linkAfter(newNode, node);
+    return newNode;
+}
+
+template<typename Type>
+void DoublyLinkedList<Type>::unlink(Node* node) {
+    if (node->prev == nullptr) {
+        m_head = node->next;
+    } else {
+        node->prev->next = node->next;
     }
     if (node->next == nullptr) {
-        newNode->prev = m_tail;
-        m_tail->next = newNode;
-        m_tail = newNode;
+        m_tail = node->prev;
+    } else {
+        node->next->prev = node->prev;
+    }
+    node->next = nullptr;
+    node->prev = nullptr;
+}
+
+template<typename Type>
+void DoublyLinkedList<Type>::linkAfter(Node* node, Node* pos) {
+    node->prev = pos;
+    node->next = (pos == nullptr) ? m_head : pos->next;
+    if (node->next == nullptr) {
+        m_tail = node;
+    } else {
+        node->next->prev = node;
+    }
+    if (pos == nullptr) {
+        m_head = node;
+    } else {
+        pos->next = node;
+    }
+}
+
+template<typename Type>
+void DoublyLinkedList<Type>::moveToHead(Node* node) {
+    if (node == nullptr || node == m_head) {
+        return;
+    }
+    unlink(node);
+    linkAfter(node, nullptr);
+}
+
+template<typename Type>
+void DoublyLinkedList<Type>::moveToTail(Node* node) {
+    if (node == nullptr || node == m_tail) {
+        return;
+    }
+    unlink(node);
+    linkAfter(node, m_tail);
+}
+
+template<typename Type>
+void DoublyLinkedList<Type>::moveAfter(Node* node, Node* pos) {
+    if (node == nullptr || node == pos || node->prev == pos) {
         return;
     }
-    newNode->next = node->next;
-    node->next = newNode;
-    newNode->prev = node;
-    newNode->next->prev = newNode;
+    unlink(node);
+    linkAfter(node, pos);
 }
 
 template<typename Type>
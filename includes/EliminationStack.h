@@ -0,0 +1,198 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_ELIMINATION_STACK_H
+#define DS_ELIMINATION_STACK_H
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include "LockFreeStack.h"
+
+/* Elimination-backoff stack.
+ * Every operation first tries a single CAS on the LockFreeStack top. A thread that
+ * loses the race backs off into a random slot of an elimination array instead of
+ * retrying at once: a waiting push hands its node straight to a pop that finds it,
+ * and the pair completes without touching the shared top. Under high contention
+ * most pairs cancel out in parallel slots, so throughput keeps scaling. */
+template<typename Type, size_t Slots = 16>
+class EliminationStack
+{
+  public:
+    EliminationStack(size_t spins = 128);
+    EliminationStack(const EliminationStack<Type, Slots>& s) = delete;
+    ~EliminationStack() { clear(); }
+
+    EliminationStack<Type, Slots>& operator=(const EliminationStack<Type, Slots>& s) = delete;
+
+    // Check if the stack is empty at this instant
+    inline bool empty() const { return m_stack.empty(); }
+
+    // Push a value to the top of the EliminationStack
+    void push(const Type value);
+
+    // Pop the top value into value. Returns false if the stack was empty.
+    bool try_pop(Type& value);
+
+    // Pop the top value of the EliminationStack
+    Type pop();
+
+    // Clear all the elements of the EliminationStack
+    void clear() { m_stack.clear(); }
+
+    // Number of push/pop pairs that met in the elimination array
+    inline size_t eliminated() const { return m_eliminated.load(std::memory_order_relaxed); }
+
+  private:
+    typedef typename LockFreeStack<Type>::Arena Arena;
+    typedef typename LockFreeStack<Type>::Index Index;
+    typedef typename LockFreeStack<Type>::Tagged Tagged;
+    typedef typename LockFreeStack<Type>::Attempt Attempt;
+
+    // A slot holds npos while free, or the node a waiting push offers
+    struct alignas(64) Exchanger
+    {
+        std::atomic<Tagged> offer;
+
+        Exchanger() : offer(Arena::pack(Arena::npos, 0)) {}
+    };
+
+    static size_t randomSlot();
+
+    // Offer node in a random slot and wait for a pop to take it
+    bool eliminatePush(Index node);
+
+    // Take a node offered in a random slot
+    bool eliminatePop(Index& node);
+
+    LockFreeStack<Type> m_stack;
+    Exchanger m_exchangers[Slots];
+    size_t m_spins;
+    std::atomic<size_t> m_eliminated;
+};
+
+template<typename Type, size_t Slots>
+EliminationStack<Type, Slots>::EliminationStack(size_t spins) : m_spins(spins), m_eliminated(0) {
+    static_assert(Slots > 0, "EliminationStack Slots has to be positive non-zero integer");
+}
+
+template<typename Type, size_t Slots>
+size_t EliminationStack<Type, Slots>::randomSlot() {
+    // xorshift32 per thread, seeded from the thread's own storage address
+    thread_local uint32_t seed = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(&seed) >> 4) | 1;
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed % Slots;
+}
+
+template<typename Type, size_t Slots>
+bool EliminationStack<Type, Slots>::eliminatePush(Index node) {
+    Exchanger& exchanger = m_exchangers[randomSlot()];
+    Tagged current = exchanger.offer.load(std::memory_order_relaxed);
+    if (Arena::indexOf(current) != Arena::npos) {
+        return false;
+    }
+    Tagged offer = Arena::pack(node, Arena::tagOf(current) + 1);
+    if (!exchanger.offer.compare_exchange_strong(current, offer, std::memory_order_release, std::memory_order_relaxed)) {
+        return false;
+    }
+    // Only a pop changes an offer, and tags never repeat, so any change means taken
+    for (size_t i = 0; i < m_spins; i++) {
+        if (exchanger.offer.load(std::memory_order_relaxed) != offer) {
+            m_eliminated.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    if (exchanger.offer.compare_exchange_strong(offer, Arena::pack(Arena::npos, Arena::tagOf(offer) + 1), std::memory_order_relaxed)) {
+        return false;
+    }
+    m_eliminated.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+template<typename Type, size_t Slots>
+bool EliminationStack<Type, Slots>::eliminatePop(Index& node) {
+    Exchanger& exchanger = m_exchangers[randomSlot()];
+    Tagged current = exchanger.offer.load(std::memory_order_relaxed);
+    if (Arena::indexOf(current) == Arena::npos) {
+        return false;
+    }
+    if (!exchanger.offer.compare_exchange_strong(current, Arena::pack(Arena::npos, Arena::tagOf(current) + 1), std::memory_order_acquire, std::memory_order_relaxed)) {
+        return false;
+    }
+    node = Arena::indexOf(current);
+    return true;
+}
+
+template<typename Type, size_t Slots>
+void EliminationStack<Type, Slots>::push(const Type value) {
+    Index node = m_stack.createNode(value);
+    if (node == Arena::npos) {
+        return;
+    }
+    while (m_stack.tryPushNode(node) != Attempt::Done) {
+        if (eliminatePush(node)) {
+            return;
+        }
+    }
+}
+
+template<typename Type, size_t Slots>
+bool EliminationStack<Type, Slots>::try_pop(Type& value) {
+    Index node;
+    while (true) {
+        Attempt attempt = m_stack.tryPopNode(node);
+        if (attempt == Attempt::Done) {
+            break;
+        }
+        if (attempt == Attempt::Empty) {
+            // A push may still be parked in the array
+            if (!eliminatePop(node)) {
+                return false;
+            }
+            break;
+        }
+        if (eliminatePop(node)) {
+            break;
+        }
+    }
+    m_stack.takeValue(node, value);
+    return true;
+}
+
+template<typename Type, size_t Slots>
+Type EliminationStack<Type, Slots>::pop() {
+    Type value = Type();
+    if (!try_pop(value)) {
+#ifdef _DEBUG
+        throw std::out_of_range("Cannot pop: EliminationStack is empty");
+#endif
+    }
+    return value;
+}
+
+#endif
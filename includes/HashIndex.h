@@ -0,0 +1,189 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_HASH_INDEX_H
+#define DS_HASH_INDEX_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+/* Open addressing hash map with linear probing.
+ * Used as the lookup half of the node based containers, so Value is usually a node pointer.
+ * Erase shifts the following entries back instead of leaving tombstones,
+ * so lookups never slow down after heavy churn. */
+template<typename Key, typename Value, typename Hash = std::hash<Key>>
+class HashIndex
+{
+  public:
+    HashIndex(size_t capacity = 0);
+    HashIndex(const HashIndex<Key, Value, Hash>& index) = delete;
+    ~HashIndex() { clear(); }
+
+    inline bool empty() const { return (m_size == 0); }
+    inline size_t size() const { return m_size; }
+
+    // Get a pointer to the value of key, nullptr if absent
+    Value* find(const Key& key) const;
+
+    // Insert a key or overwrite its value. Returns true if the key was new.
+    bool insert(const Key& key, const Value& value);
+
+    // Remove a key. Returns true if the key was present.
+    bool erase(const Key& key);
+
+    // Make room for count keys without rehashing
+    void reserve(size_t count);
+
+    void clear();
+
+  private:
+    struct Slot
+    {
+        Key key;
+        Value value;
+        bool used;
+
+        Slot() : key(Key()), value(Value()), used(false) {}
+    };
+
+    // Fibonacci hashing spreads weak hashes such as identity over all slots
+    inline size_t slotOf(const Key& key) const { return static_cast<size_t>((static_cast<uint64_t>(m_hash(key)) * 0x9E3779B97F4A7C15ULL) >> m_shift); }
+
+    // Index of the slot holding key, or of the empty slot ending its probe sequence
+    size_t probe(const Key& key) const;
+    void rehash(size_t slots);
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_mask;
+    size_t m_shift;
+    size_t m_size;
+    Hash m_hash;
+};
+
+template<typename Key, typename Value, typename Hash>
+HashIndex<Key, Value, Hash>::HashIndex(size_t capacity) : m_slots(nullptr), m_mask(0), m_shift(64), m_size(0) {
+    reserve(capacity);
+}
+
+template<typename Key, typename Value, typename Hash>
+size_t HashIndex<Key, Value, Hash>::probe(const Key& key) const {
+    size_t pos = slotOf(key);
+    while (m_slots[pos].used && !(m_slots[pos].key == key)) {
+        pos = (pos + 1) & m_mask;
+    }
+    return pos;
+}
+
+template<typename Key, typename Value, typename Hash>
+Value* HashIndex<Key, Value, Hash>::find(const Key& key) const {
+    if (m_size == 0) {
+        return nullptr;
+    }
+    size_t pos = probe(key);
+    return m_slots[pos].used ? &m_slots[pos].value : nullptr;
+}
+
+template<typename Key, typename Value, typename Hash>
+bool HashIndex<Key, Value, Hash>::insert(const Key& key, const Value& value) {
+    reserve(m_size + 1);
+    size_t pos = probe(key);
+    if (m_slots[pos].used) {
+        m_slots[pos].value = value;
+        return false;
+    }
+    m_slots[pos].key = key;
+    m_slots[pos].value = value;
+    m_slots[pos].used = true;
+    m_size++;
+    return true;
+}
+
+template<typename Key, typename Value, typename Hash>
+bool HashIndex<Key, Value, Hash>::erase(const Key& key) {
+    if (m_size == 0) {
+        return false;
+    }
+    size_t hole = probe(key);
+    if (!m_slots[hole].used) {
+        return false;
+    }
+    // Backward shift: pull later entries of the cluster into the hole
+    // unless that would move them in front of their home slot
+    size_t pos = (hole + 1) & m_mask;
+    while (m_slots[pos].used) {
+        size_t home = slotOf(m_slots[pos].key);
+        if (((pos - home) & m_mask) >= ((pos - hole) & m_mask)) {
+            m_slots[hole] = m_slots[pos];
+            hole = pos;
+        }
+        pos = (pos + 1) & m_mask;
+    }
+    m_slots[hole] = Slot();
+    m_size--;
+    return true;
+}
+
+template<typename Key, typename Value, typename Hash>
+void HashIndex<Key, Value, Hash>::reserve(size_t count) {
+    // Keep the load factor at or below 1/2
+    size_t slots = 8;
+    while (slots < count * 2) {
+        slots *= 2;
+    }
+    if (slots > m_mask + 1 || m_slots == nullptr) {
+        rehash(slots);
+    }
+}
+
+template<typename Key, typename Value, typename Hash>
+void HashIndex<Key, Value, Hash>::rehash(size_t slots) {
+    std::unique_ptr<Slot[]> old = std::move(m_slots);
+    size_t oldSlots = (old == nullptr) ? 0 : m_mask + 1;
+
+    m_slots = std::make_unique<Slot[]>(slots);
+    m_mask = slots - 1;
+    m_shift = 64;
+    while (slots > 1) {
+        slots >>= 1;
+        m_shift--;
+    }
+    for (size_t i = 0; i < oldSlots; i++) {
+        if (old[i].used) {
+            m_slots[probe(old[i].key)] = old[i];
+        }
+    }
+}
+
+template<typename Key, typename Value, typename Hash>
+void HashIndex<Key, Value, Hash>::clear() {
+    m_slots.reset();
+    m_mask = 0;
+    m_shift = 64;
+    m_size = 0;
+}
+
+#endif
@@ -0,0 +1,362 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_INDEXED_PRIORITY_QUEUE_H
+#define DS_INDEXED_PRIORITY_QUEUE_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+/* Binary heap of dense integer ids, each queued with a key (Dijkstra, A*, Prim).
+ * A position table maps every id to its place in the heap, so an id is queued at
+ * most once and its key can be changed or the id erased in O(log n) instead of
+ * pushing duplicates. The table grows to the largest id pushed; size it up front
+ * with the constructor or reserve() when the id range is known.
+ * Compare orders keys like std::priority_queue; the default std::greater puts the
+ * smallest key on top, so decrease_key moves an id towards the front. */
+template<typename Key, typename Compare = std::greater<Key>>
+class IndexedPriorityQueue
+{
+  public:
+    typedef uint32_t Index;
+    static constexpr Index npos = UINT32_MAX;
+
+    IndexedPriorityQueue(size_t ids = 0, const Compare& compare = Compare());
+    IndexedPriorityQueue(const IndexedPriorityQueue& pq) = delete;
+    IndexedPriorityQueue(IndexedPriorityQueue&& pq) noexcept;
+
+    IndexedPriorityQueue& operator=(const IndexedPriorityQueue& pq) = delete;
+    IndexedPriorityQueue& operator=(IndexedPriorityQueue&& pq) noexcept;
+
+    inline bool empty() const { return (m_size == 0); }
+    inline size_t size() const { return m_size; }
+
+    // Ids below this fit in the position table without growing it
+    inline size_t ids() const { return m_ids; }
+
+    // Id and key of the element pop() returns next
+    Index front() const;
+    Key frontKey() const;
+
+    inline bool contains(Index id) const { return id < m_ids && m_positions[id] != npos; }
+
+    // Key of a queued id
+    Key key(Index id) const;
+
+    // Queue id with key. Returns false if id is already queued or is npos.
+    bool push(Index id, const Key& key);
+
+    // Remove the front element and return its id
+    Index pop();
+
+    // Give a queued id a key that moves it towards the front, or not at all
+    void decrease_key(Index id, const Key& key);
+
+    // Give a queued id a key that moves it away from the front, or not at all
+    void increase_key(Index id, const Key& key);
+
+    // Queue id with key, or change its key in either direction if it is queued
+    void update(Index id, const Key& key);
+
+    // Returns false if id is not queued
+    bool erase(Index id);
+
+    // Make room for ids below count and for count queued elements
+    void reserve(size_t count);
+
+    void clear();
+
+  private:
+    struct Entry
+    {
+        Key key;
+        Index id;
+    };
+
+    // Throws in debug builds when id is not queued
+    bool check(Index id) const;
+
+    // Put entry at pos and record the position of its id
+    inline void place(size_t pos, Entry&& entry) {
+        m_positions[entry.id] = static_cast<Index>(pos);
+        m_heap[pos] = std::move(entry);
+    }
+
+    void siftUp(size_t pos);
+    void siftDown(size_t pos);
+
+    std::unique_ptr<Entry[]> m_heap;
+    std::unique_ptr<Index[]> m_positions;
+    size_t m_capacity;
+    size_t m_size;
+    size_t m_ids;
+    Compare m_compare;
+};
+
+template<typename Key, typename Compare>
+IndexedPriorityQueue<Key, Compare>::IndexedPriorityQueue(size_t ids, const Compare& compare)
+    : m_capacity(0), m_size(0), m_ids(0), m_compare(compare) {
+    reserve(ids);
+}
+
+template<typename Key, typename Compare>
+IndexedPriorityQueue<Key, Compare>::IndexedPriorityQueue(IndexedPriorityQueue&& pq) noexcept
+    : m_heap(std::move(pq.m_heap)), m_positions(std::move(pq.m_positions)), m_capacity(pq.m_capacity),
+      m_size(pq.m_size), m_ids(pq.m_ids), m_compare(std::move(pq.m_compare)) {
+    pq.m_capacity = pq.m_size = pq.m_ids = 0;
+}
+
+template<typename Key, typename Compare>
+IndexedPriorityQueue<Key, Compare>& IndexedPriorityQueue<Key, Compare>::operator=(IndexedPriorityQueue&& pq) noexcept {
+    if (this != &pq) {
+        m_heap = std::move(pq.m_heap);
+        m_positions = std::move(pq.m_positions);
+        m_capacity = pq.m_capacity;
+        m_size = pq.m_size;
+        m_ids = pq.m_ids;
+        m_compare = std::move(pq.m_compare);
+        pq.m_capacity = pq.m_size = pq.m_ids = 0;
+    }
+    return *this;
+}
+
+template<typename Key, typename Compare>
+void IndexedPriorityQueue<Key, Compare>::reserve(size_t count) {
+    if (count > npos) {
+#ifdef _DEBUG
+        throw std::length_error("IndexedPriorityQueue ids must be below 2^32 - 1.");
+#endif
+        count = npos;
+    }
+    if (count > m_ids) {
+        std::unique_ptr<Index[]> positions = std::make_unique<Index[]>(count);
+        for (size_t i = 0; i < count; i++) {
+            positions[i] = (i < m_ids) ? m_positions[i] : npos;
+        }
+        m_positions = std::move(positions);
+        m_ids = count;
+    }
+    if (count > m_capacity) {
+        std::unique_ptr<Entry[]> heap = std::make_unique<Entry[]>(count);
+        for (size_t i = 0; i < m_size; i++) {
+            heap[i] = std::move(m_heap[i]);
+        }
+        m_heap = std::move(heap);
+        m_capacity = count;
+    }
+}
+
+template<typename Key, typename Compare>
+bool IndexedPriorityQueue<Key, Compare>::check(Index id) const {
+    if (!contains(id)) {
+#ifdef _DEBUG
+        throw std::out_of_range("Id is not in the IndexedPriorityQueue.");
+#endif// _DEBUG
+        return false;
+    }
+    return true;
+}
+
+template<typename Key, typename Compare>
+void IndexedPriorityQueue<Key, Compare>::siftUp(size_t pos) {
+    Entry entry = std::move(m_heap[pos]);
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        if (!m_compare(m_heap[parent].key, entry.key)) {
+            break;
+        }
+        place(pos, std::move(m_heap[parent]));
+        pos = parent;
+    }
+    place(pos, std::move(entry));
+}
+
+template<typename Key, typename Compare>
+void IndexedPriorityQueue<Key, Compare>::siftDown(size_t pos) {
+    Entry entry = std::move(m_heap[pos]);
+    size_t child = 2 * pos + 1;
+    while (child < m_size) {
+        if (child + 1 < m_size && m_compare(m_heap[child].key, m_heap[child + 1].key)) {
+            child++;
+        }
+        if (!m_compare(entry.key, m_heap[child].key)) {
+            break;
+        }
+        place(pos, std::move(m_heap[child]));
+        pos = child;
+        child = 2 * pos + 1;
+    }
+    place(pos, std::move(entry));
+}
+
+template<typename Key, typename Compare>
+typename IndexedPriorityQueue<Key, Compare>::Index IndexedPriorityQueue<Key, Compare>::front() const {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("IndexedPriorityQueue is empty.");
+#endif// _DEBUG
+        return npos;
+    }
+    return m_heap[0].id;
+}
+
+template<typename Key, typename Compare>
+Key IndexedPriorityQueue<Key, Compare>::frontKey() const {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("IndexedPriorityQueue is empty.");
+#endif// _DEBUG
+        return Key();
+    }
+    return m_heap[0].key;
+}
+
+template<typename Key, typename Compare>
+Key IndexedPriorityQueue<Key, Compare>::key(Index id) const {
+    if (!check(id)) {
+        return Key();
+    }
+    return m_heap[m_positions[id]].key;
+}
+
+template<typename Key, typename Compare>
+bool IndexedPriorityQueue<Key, Compare>::push(Index id, const Key& key) {
+    if (id >= npos) {
+#ifdef _DEBUG
+        throw std::out_of_range("IndexedPriorityQueue ids must be below 2^32 - 1.");
+#endif// _DEBUG
+        return false;
+    }
+    if (contains(id)) {
+        return false;
+    }
+    if (id >= m_ids) {
+        size_t ids = m_ids < 8 ? 8 : m_ids * 2;
+        reserve(ids <= id ? size_t(id) + 1 : ids);
+    } else if (m_size == m_capacity) {
+        // Never more than m_ids elements are queued
+        reserve(m_ids);
+    }
+    place(m_size, Entry {key, id});
+    siftUp(m_size++);
+    return true;
+}
+
+template<typename Key, typename Compare>
+typename IndexedPriorityQueue<Key, Compare>::Index IndexedPriorityQueue<Key, Compare>::pop() {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("IndexedPriorityQueue is empty.");
+#endif// _DEBUG
+        return npos;
+    }
+    Index id = m_heap[0].id;
+    erase(id);
+    return id;
+}
+
+template<typename Key, typename Compare>
+void IndexedPriorityQueue<Key, Compare>::decrease_key(Index id, const Key& key) {
+    if (!check(id)) {
+        return;
+    }
+    size_t pos = m_positions[id];
+    if (m_compare(key, m_heap[pos].key)) {
+#ifdef _DEBUG
+        throw std::invalid_argument("decrease_key would move the id away from the front.");
+#endif// _DEBUG
+        update(id, key);
+        return;
+    }
+    m_heap[pos].key = key;
+    siftUp(pos);
+}
+
+template<typename Key, typename Compare>
+void IndexedPriorityQueue<Key, Compare>::increase_key(Index id, const Key& key) {
+    if (!check(id)) {
+        return;
+    }
+    size_t pos = m_positions[id];
+    if (m_compare(m_heap[pos].key, key)) {
+#ifdef _DEBUG
+        throw std::invalid_argument("increase_key would move the id towards the front.");
+#endif// _DEBUG
+        update(id, key);
+        return;
+    }
+    m_heap[pos].key = key;
+    siftDown(pos);
+}
+
+template<typename Key, typename Compare>
+void IndexedPriorityQueue<Key, Compare>::update(Index id, const Key& key) {
+    if (!contains(id)) {
+        push(id, key);
+        return;
+    }
+    size_t pos = m_positions[id];
+    bool up = m_compare(m_heap[pos].key, key);
+    m_heap[pos].key = key;
+    if (up) {
+        siftUp(pos);
+    } else {
+        siftDown(pos);
+    }
+}
+
+template<typename Key, typename Compare>
+bool IndexedPriorityQueue<Key, Compare>::erase(Index id) {
+    if (!contains(id)) {
+        return false;
+    }
+    size_t pos = m_positions[id];
+    m_positions[id] = npos;
+    m_size--;
+    if (pos == m_size) {
+        return true;
+    }
+    place(pos, std::move(m_heap[m_size]));
+    if (pos > 0 && m_compare(m_heap[(pos - 1) / 2].key, m_heap[pos].key)) {
+        siftUp(pos);
+    } else {
+        siftDown(pos);
+    }
+    return true;
+}
+
+template<typename Key, typename Compare>
+void IndexedPriorityQueue<Key, Compare>::clear() {
+    for (size_t i = 0; i < m_size; i++) {
+        m_positions[m_heap[i].id] = npos;
+    }
+    m_size = 0;
+}
+
+#endif
@@ -27,12 +27,14 @@
 #ifndef DS_LL_QUEUE_H
 #define DS_LL_QUEUE_H
 
-#include "DoublyLinkedList.h"
+#include "CompactList.h"
 
 template<typename Type>
 class LLQueue
 {
   public:
+    typedef typename CompactList<Type>::Handle Handle;
+
     LLQueue() { m_list.clear(); }
     LLQueue(const LLQueue<Type>& llq) = delete;
     ~LLQueue() { clear(); }
@@ -40,13 +42,21 @@ class LLQueue
     inline Type front() const { return m_list.getHead(); }
     inline Type back() const { return m_list.getTail(); }
     inline bool empty() const { return m_list.empty(); }
+    inline size_t size() const { return m_list.size(); }
 
-    void push(const Type value) { m_list.insert(value); }
+    // Returns a handle that can later cancel the element
+    Handle push(const Type value) { return m_list.handle(m_list.insert(value)); }
     Type pop();
     void clear() { m_list.clear(); }
 
+    // Check if the element behind the handle is still queued
+    inline bool contains(Handle handle) const { return m_list.valid(handle); }
+
+    // Remove a queued element. Returns false if it was already popped or erased.
+    bool erase(Handle handle) { return m_list.remove(handle); }
+
   private:
-    DoublyLinkedList<Type> m_list;
+    CompactList<Type> m_list;
 };
 
 template<typename Type>
@@ -29,6 +29,7 @@
 
 #include <initializer_list>
 #include <stdexcept>
+#include "NodePool.h"
 
 // Implementation of LinkedList
 template<typename Type>
@@ -37,13 +38,17 @@ class LinkedList
   public:
     class Node;
 
-    LinkedList() : m_head(nullptr) {}
+    LinkedList() : m_head(nullptr), m_pool(sizeof(Node)) {}
     LinkedList(Node* head);
     LinkedList(Type* values, size_t size);
     LinkedList(std::initializer_list<Type> values);
     LinkedList(const LinkedList<Type>& ll);
+    LinkedList(LinkedList<Type>&& ll) noexcept;
     ~LinkedList() { clear(); }
 
+    LinkedList<Type>& operator=(const LinkedList<Type>& ll);
+    LinkedList<Type>& operator=(LinkedList<Type>&& ll) noexcept;
+
     size_t size() const;
     inline bool empty() const { return (m_head == nullptr); }
 
@@ -73,7 +78,12 @@ class LinkedList
     void reverse();
 
   private:
+    // Replace the contents with copies of the nodes starting at head, in the same order.
+    // The chain is counted first so the pool can reserve it up front.
+    void copyFrom(const Node* head);
+
     Node* m_head;
+    NodePool m_pool;
 };
 
 template<typename Type>
@@ -91,41 +101,65 @@ class LinkedList<Type>::Node
 };
 
 template<typename Type>
-LinkedList<Type>::LinkedList(Node* head) {
-    if (head == nullptr) {
-        m_head = nullptr;
-    } else {
-        *m_head = *head;
-    }
+LinkedList<Type>::LinkedList(Node* head) : m_head(nullptr), m_pool(sizeof(Node)) {
+    copyFrom(head);
 }
 
 template<typename Type>
-LinkedList<Type>::LinkedList(Type* values, size_t size) : m_head(nullptr) {
+LinkedList<Type>::LinkedList(Type* values, size_t size) : m_head(nullptr), m_pool(sizeof(Node)) {
     for (size_t i = 0; i < size; i++) {
         insert(values[i]);
     }
 }
 
 template<typename Type>
-LinkedList<Type>::LinkedList(std::initializer_list<Type> values) : m_head(nullptr) {
+LinkedList<Type>::LinkedList(std::initializer_list<Type> values) : m_head(nullptr), m_pool(sizeof(Node)) {
     for (auto& val : values) {
         insert(val);
     }
 }
 
 template<typename Type>
-LinkedList<Type>::LinkedList(const LinkedList<Type>& ll) {
-    if (ll.m_head == nullptr) {
-        m_head = nullptr;
-    } else {
-        if (ll.m_head == nullptr) {
-            m_head = nullptr;
-            return;
-        }
-        if (m_head == nullptr) {
-            m_head = new Node();
-        }
-        *m_head = *(ll.m_head);
+LinkedList<Type>::LinkedList(const LinkedList<Type>& ll) : m_head(nullptr), m_pool(sizeof(Node)) {
+    copyFrom(ll.m_head);
+}
+
+template<typename Type>
+LinkedList<Type>::LinkedList(LinkedList<Type>&& ll) noexcept : m_head(ll.m_head), m_pool(std::move(ll.m_pool)) {
+    ll.m_head = nullptr;
+}
+
+template<typename Type>
+LinkedList<Type>& LinkedList<Type>::operator=(const LinkedList<Type>& ll) {
+    if (this != &ll) {
+        copyFrom(ll.m_head);
+    }
+    return *this;
+}
+
+template<typename Type>
+LinkedList<Type>& LinkedList<Type>::operator=(LinkedList<Type>&& ll) noexcept {
+    if (this != &ll) {
+        clear();
+        m_head = ll.m_head;
+        m_pool = std::move(ll.m_pool);
+        ll.m_head = nullptr;
+    }
+    return *this;
+}
+
+template<typename Type>
+void LinkedList<Type>::copyFrom(const Node* head) {
+    clear();
+    size_t count = 0;
+    for (const Node* current = head; current != nullptr; current = current->next) {
+        count++;
+    }
+    m_pool.reserve(count);
+    Node** link = &m_head;
+    for (const Node* current = head; current != nullptr; current = current->next) {
+        *link = m_pool.create<Node>(current->value);
+        link = &(*link)->next;
     }
 }
 
@@ -143,11 +177,11 @@ size_t LinkedList<Type>::size() const {
 template<typename Type>
 void LinkedList<Type>::unshift(Type value) {
     if (m_head == nullptr) {
-        m_head = new Node(value, nullptr);
+        m_head = m_pool.create<Node>(value, nullptr);
         return;
     }
 
-    m_head = new Node(value, m_head);
+    m_head = m_pool.create<Node>(value, m_head);
 }
 
 template<typename Type>
@@ -168,24 +202,24 @@ void LinkedList<Type>::insert(size_t pos, Type value) {
         current = current->next;
         iter++;
     }
-    current->next = new Node(value, current->next);
+    current->next = m_pool.create<Node>(value, current->next);
 }
 
 template<typename Type>
 void LinkedList<Type>::insert(Type value) {
     if (m_head == nullptr) {
-        m_head = new Node(value, nullptr);
+        m_head = m_pool.create<Node>(value, nullptr);
         return;
     }
     if (m_head->next == nullptr) {
-        m_head->next = new Node(value, nullptr);
+        m_head->next = m_pool.create<Node>(value, nullptr);
         return;
     }
     Node* current = m_head;
     while (current->next != nullptr) {
         current = current->next;
     }
-    current->next = new Node(value, nullptr);
+    current->next = m_pool.create<Node>(value, nullptr);
 }
 
 template<typename Type>
@@ -198,7 +232,7 @@ bool LinkedList<Type>::remove() {
     }
     Node* temp = m_head;
     m_head = m_head->next;
-    delete temp;
+    m_pool.destroy(temp);
     return true;
 }
 
@@ -218,7 +252,7 @@ bool LinkedList<Type>::remove(Type val) {
     while (current != nullptr) {
         if (current->value == val) {
             prev->next = current->next;
-            delete current;
+            m_pool.destroy(current);
             return true;
         }
         prev = current;
@@ -232,8 +266,9 @@ void LinkedList<Type>::clear() {
     while (m_head != nullptr) {
         Node* temp = m_head;
         m_head = m_head->next;
-        delete temp;
+        m_pool.destroy(temp);
     }
+    m_pool.release();
 }
 
 template<typename Type>
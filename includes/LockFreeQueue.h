@@ -0,0 +1,219 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_LOCK_FREE_QUEUE_H
+#define DS_LOCK_FREE_QUEUE_H
+
+#include <atomic>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "NodeArena.h"
+
+/* Unbounded lock-free queue (Michael & Scott) for any number of producers and consumers.
+ *
+ * Progress: push and pop are lock-free. A thread can only retry because another thread
+ * completed an operation, but a single thread may retry indefinitely. The arena takes a
+ * heap allocation when it needs a new block, which is only as lock-free as operator new.
+ *
+ * Memory: head, tail and every next link are node indices packed with a tag, so a stale
+ * CAS after ABA fails. Nodes come from a NodeArena and are recycled, never freed, while
+ * the queue lives; a node is recycled once it is neither the dummy head nor holding a
+ * value that is still being moved out. Memory is therefore bounded by the peak queue
+ * length plus one node per concurrent pop. The queue is unbounded, so producers that
+ * keep outrunning consumers grow it until allocation fails, and the arena does not
+ * shrink again afterwards. Use MPMCQueue when overrun has to be bounded. */
+template<typename Type>
+class LockFreeQueue
+{
+  public:
+    LockFreeQueue();
+    LockFreeQueue(std::initializer_list<Type> values);
+    LockFreeQueue(const LockFreeQueue<Type>& queue) = delete;
+    ~LockFreeQueue() { clear(); }
+
+    LockFreeQueue<Type>& operator=(const LockFreeQueue<Type>& queue) = delete;
+
+    /* Check if queue is empty at this instant */
+    bool empty() const;
+
+    /* Insert an element to the end of the queue */
+    void push(const Type value);
+
+    /* Remove the first element into value, false if the queue was empty */
+    bool try_pop(Type& value);
+
+    /* Remove the first element of the queue */
+    Type pop();
+
+    /* Delete all elements of the queue */
+    void clear();
+
+  private:
+    struct Node
+    {
+        std::atomic<uint64_t> next;
+        // Two owners: being the dummy head, and holding a value not yet moved out
+        std::atomic<int> owners;
+        alignas(Type) unsigned char storage[sizeof(Type)];
+
+        Node() : next(UINT32_MAX), owners(0) {}
+        inline Type* value() { return reinterpret_cast<Type*>(storage); }
+    };
+    typedef NodeArena<Node> Arena;
+    typedef typename Arena::Index Index;
+    typedef typename Arena::Tagged Tagged;
+
+    // Get a node whose next link is empty, npos if the arena is exhausted
+    Index createNode(int owners);
+
+    // Drop one owner of node and recycle it when none are left
+    void disown(Index node);
+
+    Arena m_arena;
+    alignas(64) std::atomic<Tagged> m_head;
+    alignas(64) std::atomic<Tagged> m_tail;
+};
+
+template<typename Type>
+LockFreeQueue<Type>::LockFreeQueue() {
+    Index dummy = createNode(1);
+    m_head.store(Arena::pack(dummy, 0), std::memory_order_relaxed);
+    m_tail.store(Arena::pack(dummy, 0), std::memory_order_relaxed);
+}
+
+template<typename Type>
+LockFreeQueue<Type>::LockFreeQueue(std::initializer_list<Type> values) : LockFreeQueue() {
+    for (const Type& value : values) {
+        push(value);
+    }
+}
+
+template<typename Type>
+typename LockFreeQueue<Type>::Index LockFreeQueue<Type>::createNode(int owners) {
+    Index index = m_arena.allocate();
+    if (index == Arena::npos) {
+        return Arena::npos;
+    }
+    Node& node = m_arena[index];
+    // Keep the tag moving so a CAS against the previous life of this node fails
+    Tagged next = node.next.load(std::memory_order_relaxed);
+    node.next.store(Arena::pack(Arena::npos, Arena::tagOf(next) + 1), std::memory_order_relaxed);
+    node.owners.store(owners, std::memory_order_relaxed);
+    return index;
+}
+
+template<typename Type>
+void LockFreeQueue<Type>::disown(Index node) {
+    if (m_arena[node].owners.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        m_arena.deallocate(node);
+    }
+}
+
+template<typename Type>
+bool LockFreeQueue<Type>::empty() const {
+    Tagged head = m_head.load(std::memory_order_acquire);
+    return Arena::indexOf(m_arena[Arena::indexOf(head)].next.load(std::memory_order_acquire)) == Arena::npos;
+}
+
+template<typename Type>
+void LockFreeQueue<Type>::push(const Type value) {
+    Index node = createNode(2);
+    if (node == Arena::npos) {
+#ifdef _DEBUG
+        throw std::length_error("Cannot push: LockFreeQueue is full");
+#endif
+        return;
+    }
+    new (m_arena[node].value()) Type(value);
+
+    while (true) {
+        Tagged tail = m_tail.load(std::memory_order_acquire);
+        Node& last = m_arena[Arena::indexOf(tail)];
+        Tagged next = last.next.load(std::memory_order_acquire);
+        if (tail != m_tail.load(std::memory_order_acquire)) {
+            continue;
+        }
+        if (Arena::indexOf(next) == Arena::npos) {
+            if (last.next.compare_exchange_weak(next, Arena::pack(node, Arena::tagOf(next) + 1), std::memory_order_release, std::memory_order_relaxed)) {
+                m_tail.compare_exchange_strong(tail, Arena::pack(node, Arena::tagOf(tail) + 1), std::memory_order_release, std::memory_order_relaxed);
+                return;
+            }
+        } else {
+            // Tail is lagging behind: help the other push finish
+            m_tail.compare_exchange_strong(tail, Arena::pack(Arena::indexOf(next), Arena::tagOf(tail) + 1), std::memory_order_release, std::memory_order_relaxed);
+        }
+    }
+}
+
+template<typename Type>
+bool LockFreeQueue<Type>::try_pop(Type& value) {
+    while (true) {
+        Tagged head = m_head.load(std::memory_order_acquire);
+        Tagged tail = m_tail.load(std::memory_order_acquire);
+        Tagged next = m_arena[Arena::indexOf(head)].next.load(std::memory_order_acquire);
+        if (head != m_head.load(std::memory_order_acquire)) {
+            continue;
+        }
+        if (Arena::indexOf(next) == Arena::npos) {
+            return false;
+        }
+        if (Arena::indexOf(head) == Arena::indexOf(tail)) {
+            m_tail.compare_exchange_strong(tail, Arena::pack(Arena::indexOf(next), Arena::tagOf(tail) + 1), std::memory_order_release, std::memory_order_relaxed);
+            continue;
+        }
+        if (m_head.compare_exchange_weak(head, Arena::pack(Arena::indexOf(next), Arena::tagOf(head) + 1), std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            // next is the new dummy; its value is ours until we disown it
+            Type* stored = m_arena[Arena::indexOf(next)].value();
+            value = std::move(*stored);
+            stored->~Type();
+            disown(Arena::indexOf(next));
+            disown(Arena::indexOf(head));
+            return true;
+        }
+    }
+}
+
+template<typename Type>
+Type LockFreeQueue<Type>::pop() {
+    Type value = Type();
+    if (!try_pop(value)) {
+#ifdef _DEBUG
+        throw std::out_of_range("LockFreeQueue is empty.");
+#endif// _DEBUG
+    }
+    return value;
+}
+
+template<typename Type>
+void LockFreeQueue<Type>::clear() {
+    Type value;
+    while (try_pop(value)) {
+    }
+}
+
+#endif
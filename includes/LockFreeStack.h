@@ -0,0 +1,254 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_LOCK_FREE_STACK_H
+#define DS_LOCK_FREE_STACK_H
+
+#include <atomic>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "NodeArena.h"
+
+/* Lock-free Treiber stack.
+ * The top is a node index packed with a tag that changes on every update, so a
+ * stale CAS after an ABA sequence fails. Nodes come from a NodeArena and are only
+ * recycled, never freed, while the stack lives, which makes reading a node that
+ * another thread just popped safe. Memory is bounded by the peak number of elements. */
+template<typename Type>
+class LockFreeStack
+{
+  public:
+    LockFreeStack();
+    LockFreeStack(std::initializer_list<Type> values);
+    LockFreeStack(const LockFreeStack<Type>& s) = delete;
+    ~LockFreeStack() { clear(); }
+
+    LockFreeStack<Type>& operator=(const LockFreeStack<Type>& s) = delete;
+
+    // Check if the stack is empty at this instant
+    inline bool empty() const { return Arena::indexOf(m_top.load(std::memory_order_acquire)) == Arena::npos; }
+
+    // Push a value to the top of the LockFreeStack
+    void push(const Type value);
+
+    // Pop the top value into value. Returns false if the stack was empty.
+    bool try_pop(Type& value);
+
+    // Pop the top value of the LockFreeStack
+    Type pop();
+
+    // Push a range with a single CAS; the last value ends up on top
+    template<typename Iterator>
+    void push_all(Iterator first, Iterator last);
+    void push_all(std::initializer_list<Type> values) { push_all(values.begin(), values.end()); }
+
+    // Detach the whole stack with a single CAS and visit the values top to bottom.
+    // Returns the number of values visited.
+    template<typename Func>
+    size_t pop_all(Func visit);
+
+    // Clear all the elements of the LockFreeStack
+    void clear();
+
+  private:
+    struct Node
+    {
+        std::atomic<uint32_t> next;
+        alignas(Type) unsigned char storage[sizeof(Type)];
+
+        Node() : next(UINT32_MAX) {}
+        inline Type* value() { return reinterpret_cast<Type*>(storage); }
+    };
+    typedef NodeArena<Node> Arena;
+    typedef typename Arena::Index Index;
+    typedef typename Arena::Tagged Tagged;
+
+    // Get a node holding value, npos if the arena is exhausted
+    Index createNode(const Type& value);
+
+    // Link the private chain first..last in as the new top
+    void pushChain(Index first, Index last);
+
+    // Single CAS attempts used by EliminationStack to back off on contention
+    enum class Attempt { Done, Empty, Contended };
+    Attempt tryPushNode(Index node);
+    Attempt tryPopNode(Index& node);
+
+    // Move the value out of a popped node and recycle the node
+    void takeValue(Index node, Type& value);
+
+    Arena m_arena;
+    // On its own cache line, it is the only contended word
+    alignas(64) std::atomic<Tagged> m_top;
+
+    template<typename, size_t>
+    friend class EliminationStack;
+};
+
+template<typename Type>
+LockFreeStack<Type>::LockFreeStack() : m_top(Arena::pack(Arena::npos, 0)) {}
+
+template<typename Type>
+LockFreeStack<Type>::LockFreeStack(std::initializer_list<Type> values) : LockFreeStack() {
+    push_all(values);
+}
+
+template<typename Type>
+typename LockFreeStack<Type>::Index LockFreeStack<Type>::createNode(const Type& value) {
+    Index index = m_arena.allocate();
+    if (index == Arena::npos) {
+#ifdef _DEBUG
+        throw std::length_error("Cannot push: LockFreeStack is full");
+#endif
+        return Arena::npos;
+    }
+    new (m_arena[index].value()) Type(value);
+    return index;
+}
+
+template<typename Type>
+void LockFreeStack<Type>::pushChain(Index first, Index last) {
+    Tagged top = m_top.load(std::memory_order_relaxed);
+    do {
+        m_arena[last].next.store(Arena::indexOf(top), std::memory_order_relaxed);
+    } while (!m_top.compare_exchange_weak(top, Arena::pack(first, Arena::tagOf(top) + 1), std::memory_order_release, std::memory_order_relaxed));
+}
+
+template<typename Type>
+void LockFreeStack<Type>::push(const Type value) {
+    Index node = createNode(value);
+    if (node != Arena::npos) {
+        pushChain(node, node);
+    }
+}
+
+template<typename Type>
+template<typename Iterator>
+void LockFreeStack<Type>::push_all(Iterator first, Iterator last) {
+    // Build the chain privately, newest value at its head
+    Index head = Arena::npos;
+    Index tail = Arena::npos;
+    for (; first != last; ++first) {
+        Index node = createNode(*first);
+        if (node == Arena::npos) {
+            break;
+        }
+        m_arena[node].next.store(head, std::memory_order_relaxed);
+        if (tail == Arena::npos) {
+            tail = node;
+        }
+        head = node;
+    }
+    if (head != Arena::npos) {
+        pushChain(head, tail);
+    }
+}
+
+template<typename Type>
+typename LockFreeStack<Type>::Attempt LockFreeStack<Type>::tryPushNode(Index node) {
+    Tagged top = m_top.load(std::memory_order_relaxed);
+    m_arena[node].next.store(Arena::indexOf(top), std::memory_order_relaxed);
+    if (m_top.compare_exchange_strong(top, Arena::pack(node, Arena::tagOf(top) + 1), std::memory_order_release, std::memory_order_relaxed)) {
+        return Attempt::Done;
+    }
+    return Attempt::Contended;
+}
+
+template<typename Type>
+typename LockFreeStack<Type>::Attempt LockFreeStack<Type>::tryPopNode(Index& node) {
+    Tagged top = m_top.load(std::memory_order_acquire);
+    if (Arena::indexOf(top) == Arena::npos) {
+        return Attempt::Empty;
+    }
+    // May read a node popped meanwhile; the tag then fails the CAS
+    Index next = m_arena[Arena::indexOf(top)].next.load(std::memory_order_relaxed);
+    if (m_top.compare_exchange_strong(top, Arena::pack(next, Arena::tagOf(top) + 1), std::memory_order_acquire, std::memory_order_relaxed)) {
+        node = Arena::indexOf(top);
+        return Attempt::Done;
+    }
+    return Attempt::Contended;
+}
+
+template<typename Type>
+void LockFreeStack<Type>::takeValue(Index node, Type& value) {
+    Type* stored = m_arena[node].value();
+    value = std::move(*stored);
+    stored->~Type();
+    m_arena.deallocate(node);
+}
+
+template<typename Type>
+bool LockFreeStack<Type>::try_pop(Type& value) {
+    Index node;
+    Attempt attempt;
+    while ((attempt = tryPopNode(node)) == Attempt::Contended) {
+    }
+    if (attempt == Attempt::Empty) {
+        return false;
+    }
+    takeValue(node, value);
+    return true;
+}
+
+template<typename Type>
+Type LockFreeStack<Type>::pop() {
+    Type value = Type();
+    if (!try_pop(value)) {
+#ifdef _DEBUG
+        throw std::out_of_range("Cannot pop: LockFreeStack is empty");
+#endif
+    }
+    return value;
+}
+
+template<typename Type>
+template<typename Func>
+size_t LockFreeStack<Type>::pop_all(Func visit) {
+    Tagged top = m_top.load(std::memory_order_relaxed);
+    while (!m_top.compare_exchange_weak(top, Arena::pack(Arena::npos, Arena::tagOf(top) + 1), std::memory_order_acquire, std::memory_order_relaxed)) {
+    }
+    size_t count = 0;
+    Index node = Arena::indexOf(top);
+    while (node != Arena::npos) {
+        Index next = m_arena[node].next.load(std::memory_order_relaxed);
+        Type* stored = m_arena[node].value();
+        visit(std::move(*stored));
+        stored->~Type();
+        m_arena.deallocate(node);
+        node = next;
+        count++;
+    }
+    return count;
+}
+
+template<typename Type>
+void LockFreeStack<Type>::clear() {
+    pop_all([](Type&&) {});
+}
+
+#endif
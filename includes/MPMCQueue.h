@@ -0,0 +1,176 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_MPMC_QUEUE_H
+#define DS_MPMC_QUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+
+/* Bounded lock-free queue for any number of producers and consumers (Vyukov).
+ * Every cell carries a sequence number that says whose turn it is: a producer may
+ * fill cell i when its sequence equals the enqueue position, a consumer may empty it
+ * when the sequence is one past. Claiming a cell is a single CAS on the position,
+ * and nothing is allocated after construction. */
+template<typename Type>
+class MPMCQueue
+{
+  public:
+    MPMCQueue(size_t capacity = 1024);
+    MPMCQueue(const MPMCQueue<Type>& queue) = delete;
+
+    MPMCQueue<Type>& operator=(const MPMCQueue<Type>& queue) = delete;
+
+    inline size_t capacity() const { return m_mask + 1; }
+
+    // Approximate while other threads are running
+    size_t size() const;
+    inline bool empty() const { return size() == 0; }
+
+    // Returns false if the queue is full
+    bool try_push(const Type& value);
+
+    // Returns false if the queue is empty
+    bool try_pop(Type& value);
+
+    // Wait until there is room; spins briefly and then yields the thread
+    void push(const Type& value);
+
+    // Wait until there is a value; spins briefly and then yields the thread
+    Type pop();
+
+  private:
+    static constexpr size_t cacheLine = 64;
+    static constexpr size_t spinLimit = 64;
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        Type value;
+    };
+
+    // Back off between failed attempts of the blocking functions
+    static void wait(size_t& attempt);
+
+    std::unique_ptr<Cell[]> m_cells;
+    size_t m_mask;
+    alignas(cacheLine) std::atomic<size_t> m_enqueue;
+    alignas(cacheLine) std::atomic<size_t> m_dequeue;
+};
+
+template<typename Type>
+MPMCQueue<Type>::MPMCQueue(size_t capacity) : m_enqueue(0), m_dequeue(0) {
+    size_t rounded = 2;
+    while (rounded < capacity) {
+        rounded *= 2;
+    }
+    m_cells = std::make_unique<Cell[]>(rounded);
+    m_mask = rounded - 1;
+    for (size_t i = 0; i < rounded; i++) {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<typename Type>
+size_t MPMCQueue<Type>::size() const {
+    size_t enqueue = m_enqueue.load(std::memory_order_relaxed);
+    size_t dequeue = m_dequeue.load(std::memory_order_relaxed);
+    return (enqueue > dequeue) ? enqueue - dequeue : 0;
+}
+
+template<typename Type>
+bool MPMCQueue<Type>::try_push(const Type& value) {
+    size_t pos = m_enqueue.load(std::memory_order_relaxed);
+    while (true) {
+        Cell& cell = m_cells[pos & m_mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (m_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                cell.value = value;
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // The consumer of the previous lap has not emptied this cell yet
+            return false;
+        } else {
+            pos = m_enqueue.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template<typename Type>
+bool MPMCQueue<Type>::try_pop(Type& value) {
+    size_t pos = m_dequeue.load(std::memory_order_relaxed);
+    while (true) {
+        Cell& cell = m_cells[pos & m_mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+        if (diff == 0) {
+            if (m_dequeue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                value = std::move(cell.value);
+                cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            // No producer has filled this cell yet
+            return false;
+        } else {
+            pos = m_dequeue.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template<typename Type>
+void MPMCQueue<Type>::wait(size_t& attempt) {
+    if (++attempt >= spinLimit) {
+        std::this_thread::yield();
+    }
+}
+
+template<typename Type>
+void MPMCQueue<Type>::push(const Type& value) {
+    size_t attempt = 0;
+    while (!try_push(value)) {
+        wait(attempt);
+    }
+}
+
+template<typename Type>
+Type MPMCQueue<Type>::pop() {
+    Type value = Type();
+    size_t attempt = 0;
+    while (!try_pop(value)) {
+        wait(attempt);
+    }
+    return value;
+}
+
+#endif
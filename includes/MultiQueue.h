@@ -0,0 +1,207 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_MULTI_QUEUE_H
+#define DS_MULTI_QUEUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <thread>
+#include "DaryHeap.h"
+
+/* Relaxed concurrent priority queue (MultiQueue, Rihani, Sanders and Dementiev).
+ * The elements are spread over factor * threads sequential heaps, each behind its own
+ * lock. push adds to a random heap and try_pop takes the better of the tops of two
+ * random heaps, so threads rarely meet on a lock and no heap is a hot spot. In exchange
+ * pop is not exact: the value returned is close to the top, and a larger factor trades
+ * more rank error for less contention. With factor 2 the expected rank error grows
+ * linearly with the number of heaps and does not depend on the number of elements. */
+template<typename Type, typename Compare = std::less<Type>>
+class MultiQueue
+{
+  public:
+    // threads 0 means std::thread::hardware_concurrency()
+    MultiQueue(size_t threads = 0, size_t factor = 2, const Compare& compare = Compare());
+    MultiQueue(const MultiQueue& queue) = delete;
+    ~MultiQueue();
+
+    MultiQueue& operator=(const MultiQueue& queue) = delete;
+
+    inline size_t heaps() const { return m_count; }
+
+    // Approximate while other threads are running
+    inline size_t size() const { return m_size.load(std::memory_order_relaxed); }
+    inline bool empty() const { return size() == 0; }
+
+    void push(const Type& value);
+
+    // Take a value near the top. Returns false if the queue is empty.
+    bool try_pop(Type& value);
+
+    // Not thread-safe
+    void clear();
+
+  private:
+    static constexpr size_t cacheLine = 64;
+    static constexpr size_t spinLimit = 64;
+
+    // One cache line per heap so neighbouring locks don't false-share
+    struct alignas(cacheLine) Shard
+    {
+        std::mutex mutex;
+        DaryHeap<Type, 4, Compare> heap;
+
+        explicit Shard(const Compare& compare) : heap(compare) {}
+    };
+
+    // Per-thread xorshift, cheap enough to call on every operation
+    static size_t random();
+
+    // Lock every heap in turn and pop from the first that has a value
+    bool popAny(Type& value);
+
+    // Raw cache-aligned storage so every shard is built with the caller's comparator
+    Shard* m_shards;
+    size_t m_count;
+    Compare m_compare;
+    alignas(cacheLine) std::atomic<size_t> m_size;
+};
+
+template<typename Type, typename Compare>
+MultiQueue<Type, Compare>::MultiQueue(size_t threads, size_t factor, const Compare& compare)
+    : m_compare(compare), m_size(0) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    m_count = (threads == 0 ? 1 : threads) * (factor == 0 ? 1 : factor);
+    m_shards = static_cast<Shard*>(::operator new(m_count * sizeof(Shard), std::align_val_t(cacheLine)));
+    size_t built = 0;
+    try {
+        for (; built < m_count; built++) {
+            new (&m_shards[built]) Shard(compare);
+        }
+    } catch (...) {
+        while (built > 0) {
+            m_shards[--built].~Shard();
+        }
+        ::operator delete(m_shards, std::align_val_t(cacheLine));
+        throw;
+    }
+}
+
+template<typename Type, typename Compare>
+MultiQueue<Type, Compare>::~MultiQueue() {
+    for (size_t i = 0; i < m_count; i++) {
+        m_shards[i].~Shard();
+    }
+    ::operator delete(m_shards, std::align_val_t(cacheLine));
+}
+
+template<typename Type, typename Compare>
+size_t MultiQueue<Type, Compare>::random() {
+    thread_local uint64_t state = reinterpret_cast<uintptr_t>(&state) * 0x9E3779B97F4A7C15ULL | 1;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return static_cast<size_t>(state >> 16);
+}
+
+template<typename Type, typename Compare>
+void MultiQueue<Type, Compare>::push(const Type& value) {
+    while (true) {
+        Shard& shard = m_shards[random() % m_count];
+        if (shard.mutex.try_lock()) {
+            shard.heap.push(value);
+            // Count the value before it can be popped so m_size never drops below zero
+            m_size.fetch_add(1, std::memory_order_relaxed);
+            shard.mutex.unlock();
+            return;
+        }
+    }
+}
+
+template<typename Type, typename Compare>
+bool MultiQueue<Type, Compare>::try_pop(Type& value) {
+    size_t attempt = 0;
+    while (m_size.load(std::memory_order_relaxed) != 0) {
+        if (++attempt > spinLimit) {
+            // The two random heaps keep coming up empty or locked
+            return popAny(value);
+        }
+        size_t first = random() % m_count;
+        size_t second = (m_count > 1) ? (first + 1 + random() % (m_count - 1)) % m_count : first;
+        std::unique_lock<std::mutex> lockFirst(m_shards[first].mutex, std::try_to_lock);
+        if (!lockFirst.owns_lock()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lockSecond;
+        if (second != first) {
+            lockSecond = std::unique_lock<std::mutex>(m_shards[second].mutex, std::try_to_lock);
+            if (!lockSecond.owns_lock()) {
+                continue;
+            }
+        }
+        DaryHeap<Type, 4, Compare>* heap = &m_shards[first].heap;
+        DaryHeap<Type, 4, Compare>& other = m_shards[second].heap;
+        if (heap->empty() || (!other.empty() && m_compare(heap->front(), other.front()))) {
+            heap = &other;
+        }
+        if (!heap->empty()) {
+            value = heap->pop();
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename Type, typename Compare>
+bool MultiQueue<Type, Compare>::popAny(Type& value) {
+    size_t start = random() % m_count;
+    for (size_t i = 0; i < m_count; i++) {
+        Shard& shard = m_shards[(start + i) % m_count];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        if (!shard.heap.empty()) {
+            value = shard.heap.pop();
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename Type, typename Compare>
+void MultiQueue<Type, Compare>::clear() {
+    for (size_t i = 0; i < m_count; i++) {
+        m_shards[i].heap.clear();
+    }
+    m_size.store(0, std::memory_order_relaxed);
+}
+
+#endif
@@ -0,0 +1,165 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_NODE_ARENA_H
+#define DS_NODE_ARENA_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/* Thread-safe node storage for the lock-free containers.
+ * Nodes are addressed by 32-bit indices and live in blocks that double in size,
+ * so an index never moves and a node is never returned to the system while the
+ * arena lives. A thread that still reads a recycled node therefore reads valid
+ * memory, and the tag packed next to every index makes its CAS fail.
+ * Freed indices are recycled through a tagged lock-free free-list. */
+template<typename Node>
+class NodeArena
+{
+  public:
+    typedef uint32_t Index;
+    static constexpr Index npos = UINT32_MAX;
+
+    // An index and an ABA tag packed in one word
+    typedef uint64_t Tagged;
+    static inline Tagged pack(Index index, uint32_t tag) { return (static_cast<uint64_t>(tag) << 32) | index; }
+    static inline Index indexOf(Tagged tagged) { return static_cast<Index>(tagged); }
+    static inline uint32_t tagOf(Tagged tagged) { return static_cast<uint32_t>(tagged >> 32); }
+
+    NodeArena();
+    NodeArena(const NodeArena<Node>& arena) = delete;
+    ~NodeArena();
+
+    NodeArena<Node>& operator=(const NodeArena<Node>& arena) = delete;
+
+    inline Node& operator[](Index index) const { return slot(index).node; }
+
+    // Get a node, npos once 2^32 - 1 nodes are live
+    Index allocate();
+
+    // Return a node to the free-list. Its contents are left untouched.
+    void deallocate(Index index);
+
+    // Number of nodes ever carved out of the blocks
+    inline size_t allocated() const { return m_next.load(std::memory_order_relaxed); }
+
+  private:
+    static constexpr size_t firstBlock = 64;
+    static constexpr size_t maxBlocks = 27;
+
+    struct Slot
+    {
+        Node node;
+        std::atomic<Index> freeNext;
+
+        Slot() : node(), freeNext(npos) {}
+    };
+
+    static size_t blockOf(Index index);
+    static inline size_t blockStart(size_t block) { return firstBlock * ((size_t(1) << block) - 1); }
+    Slot& slot(Index index) const;
+
+    mutable std::atomic<Slot*> m_blocks[maxBlocks];
+    std::atomic<Tagged> m_free;
+    std::atomic<size_t> m_next;
+};
+
+template<typename Node>
+NodeArena<Node>::NodeArena() : m_free(pack(npos, 0)), m_next(0) {
+    for (size_t i = 0; i < maxBlocks; i++) {
+        m_blocks[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+template<typename Node>
+NodeArena<Node>::~NodeArena() {
+    for (size_t i = 0; i < maxBlocks; i++) {
+        delete[] m_blocks[i].load(std::memory_order_relaxed);
+    }
+}
+
+template<typename Node>
+size_t NodeArena<Node>::blockOf(Index index) {
+    // Block b holds indices [firstBlock * (2^b - 1), firstBlock * (2^(b + 1) - 1))
+    uint64_t n = index / firstBlock + 1;
+#if defined(_MSC_VER)
+    unsigned long bit;
+    _BitScanReverse64(&bit, n);
+    return bit;
+#else
+    return 63 - __builtin_clzll(n);
+#endif
+}
+
+template<typename Node>
+typename NodeArena<Node>::Slot& NodeArena<Node>::slot(Index index) const {
+    size_t block = blockOf(index);
+    Slot* slots = m_blocks[block].load(std::memory_order_acquire);
+    if (slots == nullptr) {
+        // The allocating thread publishes the block; install it ourselves if we got here first
+        Slot* fresh = new Slot[firstBlock << block];
+        if (m_blocks[block].compare_exchange_strong(slots, fresh, std::memory_order_acq_rel)) {
+            slots = fresh;
+        } else {
+            delete[] fresh;
+        }
+    }
+    return slots[index - blockStart(block)];
+}
+
+template<typename Node>
+typename NodeArena<Node>::Index NodeArena<Node>::allocate() {
+    Tagged head = m_free.load(std::memory_order_acquire);
+    while (indexOf(head) != npos) {
+        Index next = slot(indexOf(head)).freeNext.load(std::memory_order_relaxed);
+        if (m_free.compare_exchange_weak(head, pack(next, tagOf(head) + 1), std::memory_order_acquire, std::memory_order_acquire)) {
+            return indexOf(head);
+        }
+    }
+    size_t index = m_next.fetch_add(1, std::memory_order_relaxed);
+    if (index >= npos) {
+        m_next.fetch_sub(1, std::memory_order_relaxed);
+        return npos;
+    }
+    slot(static_cast<Index>(index));
+    return static_cast<Index>(index);
+}
+
+template<typename Node>
+void NodeArena<Node>::deallocate(Index index) {
+    Slot& freed = slot(index);
+    Tagged head = m_free.load(std::memory_order_relaxed);
+    do {
+        freed.freeNext.store(indexOf(head), std::memory_order_relaxed);
+    } while (!m_free.compare_exchange_weak(head, pack(index, tagOf(head) + 1), std::memory_order_release, std::memory_order_relaxed));
+}
+
+#endif
@@ -0,0 +1,265 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_NODE_POOL_H
+#define DS_NODE_POOL_H
+
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// Fixed-size node allocator shared by the node based containers.
+// Nodes are carved out of large blocks and recycled through a free-list,
+// so a container that keeps inserting and removing does no heap traffic
+// once it has warmed up. All memory is returned in release().
+class NodePool
+{
+  public:
+    NodePool(size_t nodeSize = 0, size_t nodesPerBlock = 64);
+    NodePool(const NodePool& pool) = delete;
+    NodePool(NodePool&& pool) noexcept;
+    ~NodePool() { release(); }
+
+    NodePool& operator=(const NodePool& pool) = delete;
+    NodePool& operator=(NodePool&& pool) noexcept;
+
+    // Size of a single node slot in bytes
+    inline size_t nodeSize() const { return m_nodeSize; }
+
+    // Get raw storage for one node
+    void* allocate();
+
+    // Return the storage of one node to the free-list
+    void deallocate(void* node);
+
+    // Make sure count nodes can be allocated without touching the heap again.
+    // The shortfall is allocated as a single block.
+    void reserve(size_t count);
+
+    // Free every block. Nodes allocated from the pool must already be destroyed.
+    void release();
+
+    void swap(NodePool& pool) noexcept;
+
+    // Take over every block and free node of pool, so nodes allocated from it can be
+    // destroyed through this pool. The free-lists are joined in O(1); what is left of
+    // pool's current block is freed node by node unless this pool has no current block,
+    // which costs at most one block. Both pools need the same nodeSize().
+    void splice(NodePool& pool);
+
+    // Construct a Node in pooled storage
+    template<typename Node, typename... Args>
+    Node* create(Args&&... args);
+
+    // Destroy a Node and recycle its storage
+    template<typename Node>
+    void destroy(Node* node);
+
+  private:
+    struct FreeNode
+    {
+        FreeNode* next;
+    };
+
+    struct Block
+    {
+        Block* next;
+    };
+
+    static constexpr size_t alignment = alignof(std::max_align_t);
+    static constexpr size_t roundUp(size_t size) { return (size + alignment - 1) / alignment * alignment; }
+
+    void addBlock(size_t count);
+
+    size_t m_nodeSize;
+    size_t m_nodesPerBlock;
+    Block* m_blocks;
+    // The oldest block, end of the m_blocks chain
+    Block* m_lastBlock;
+    FreeNode* m_free;
+    // Last node of the free-list, so splice() can join two free-lists
+    FreeNode* m_freeTail;
+    char* m_cursor;
+    char* m_end;
+};
+
+inline NodePool::NodePool(size_t nodeSize, size_t nodesPerBlock)
+    : m_nodeSize(roundUp(nodeSize < sizeof(FreeNode) ? sizeof(FreeNode) : nodeSize)),
+      m_nodesPerBlock(nodesPerBlock == 0 ? 1 : nodesPerBlock),
+      m_blocks(nullptr), m_lastBlock(nullptr), m_free(nullptr), m_freeTail(nullptr), m_cursor(nullptr), m_end(nullptr) {}
+
+inline NodePool::NodePool(NodePool&& pool) noexcept
+    : m_nodeSize(pool.m_nodeSize), m_nodesPerBlock(pool.m_nodesPerBlock),
+      m_blocks(pool.m_blocks), m_lastBlock(pool.m_lastBlock), m_free(pool.m_free), m_freeTail(pool.m_freeTail),
+      m_cursor(pool.m_cursor), m_end(pool.m_end) {
+    pool.m_blocks = pool.m_lastBlock = nullptr;
+    pool.m_free = pool.m_freeTail = nullptr;
+    pool.m_cursor = pool.m_end = nullptr;
+}
+
+inline NodePool& NodePool::operator=(NodePool&& pool) noexcept {
+    if (this != &pool) {
+        release();
+        swap(pool);
+    }
+    return *this;
+}
+
+inline void* NodePool::allocate() {
+    if (m_free != nullptr) {
+        FreeNode* node = m_free;
+        m_free = m_free->next;
+        if (m_free == nullptr) {
+            m_freeTail = nullptr;
+        }
+        return node;
+    }
+    if (m_cursor == m_end) {
+        addBlock(m_nodesPerBlock);
+    }
+    void* node = m_cursor;
+    m_cursor += m_nodeSize;
+    return node;
+}
+
+inline void NodePool::deallocate(void* node) {
+    if (node == nullptr) {
+        return;
+    }
+    FreeNode* freeNode = static_cast<FreeNode*>(node);
+    freeNode->next = m_free;
+    if (m_free == nullptr) {
+        m_freeTail = freeNode;
+    }
+    m_free = freeNode;
+}
+
+inline void NodePool::reserve(size_t count) {
+    size_t available = static_cast<size_t>(m_end - m_cursor) / m_nodeSize;
+    for (FreeNode* node = m_free; node != nullptr && available < count; node = node->next) {
+        available++;
+    }
+    if (available >= count) {
+        return;
+    }
+    addBlock(count - available);
+}
+
+inline void NodePool::release() {
+    while (m_blocks != nullptr) {
+        Block* next = m_blocks->next;
+        ::operator delete(m_blocks);
+        m_blocks = next;
+    }
+    m_lastBlock = nullptr;
+    m_free = m_freeTail = nullptr;
+    m_cursor = m_end = nullptr;
+}
+
+inline void NodePool::swap(NodePool& pool) noexcept {
+    std::swap(m_nodeSize, pool.m_nodeSize);
+    std::swap(m_nodesPerBlock, pool.m_nodesPerBlock);
+    std::swap(m_blocks, pool.m_blocks);
+    std::swap(m_lastBlock, pool.m_lastBlock);
+    std::swap(m_free, pool.m_free);
+    std::swap(m_freeTail, pool.m_freeTail);
+    std::swap(m_cursor, pool.m_cursor);
+    std::swap(m_end, pool.m_end);
+}
+
+inline void NodePool::addBlock(size_t count) {
+    // Hand whatever is left of the current block to the free-list
+    while (m_cursor != m_end) {
+        deallocate(m_cursor);
+        m_cursor += m_nodeSize;
+    }
+    char* memory = static_cast<char*>(::operator new(roundUp(sizeof(Block)) + count * m_nodeSize));
+    Block* block = reinterpret_cast<Block*>(memory);
+    block->next = m_blocks;
+    if (m_blocks == nullptr) {
+        m_lastBlock = block;
+    }
+    m_blocks = block;
+    m_cursor = memory + roundUp(sizeof(Block));
+    m_end = m_cursor + count * m_nodeSize;
+}
+
+inline void NodePool::splice(NodePool& pool) {
+    if (&pool == this || pool.m_blocks == nullptr) {
+        return;
+    }
+#ifdef _DEBUG
+    if (pool.m_nodeSize != m_nodeSize) {
+        throw std::invalid_argument("Cannot splice NodePools of different node sizes.");
+    }
+#endif// _DEBUG
+    pool.m_lastBlock->next = m_blocks;
+    if (m_blocks == nullptr) {
+        m_lastBlock = pool.m_lastBlock;
+    }
+    m_blocks = pool.m_blocks;
+    if (pool.m_free != nullptr) {
+        pool.m_freeTail->next = m_free;
+        if (m_free == nullptr) {
+            m_freeTail = pool.m_freeTail;
+        }
+        m_free = pool.m_free;
+    }
+    if (m_cursor == m_end) {
+        m_cursor = pool.m_cursor;
+        m_end = pool.m_end;
+    } else {
+        for (char* node = pool.m_cursor; node != pool.m_end; node += m_nodeSize) {
+            deallocate(node);
+        }
+    }
+    pool.m_blocks = pool.m_lastBlock = nullptr;
+    pool.m_free = pool.m_freeTail = nullptr;
+    pool.m_cursor = pool.m_end = nullptr;
+}
+
+template<typename Node, typename... Args>
+Node* NodePool::create(Args&&... args) {
+    void* memory = allocate();
+    try {
+        return new (memory) Node(std::forward<Args>(args)...);
+    } catch (...) {
+        deallocate(memory);
+        throw;
+    }
+}
+
+template<typename Node>
+void NodePool::destroy(Node* node) {
+    if (node == nullptr) {
+        return;
+    }
+    node->~Node();
+    deallocate(node);
+}
+
+#endif
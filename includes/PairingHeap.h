@@ -0,0 +1,332 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_PAIRING_HEAP_H
+#define DS_PAIRING_HEAP_H
+
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include "NodePool.h"
+
+/* Mergeable priority queue as a pairing heap.
+ * push and meld link two trees in O(1); pop pairs up the children of the root
+ * left to right and folds the pairs right to left, in amortized O(log n).
+ * Nodes come from a NodePool and meld splices the other heap's pool into this one,
+ * so melding moves no elements and every handle of either heap stays valid. Blocks
+ * taken over by meld stay with this heap until it is next empty, when pop or erase
+ * return them all; a heap that absorbs melds without ever running empty keeps the
+ * blocks of every heap melded into it until clear().
+ * Compare orders values like std::priority_queue; the default std::greater puts the
+ * smallest value on top, so decrease_key moves an element towards the front.
+ * A Handle stays valid until its element is popped, erased or the heap is cleared. */
+template<typename Type, typename Compare = std::greater<Type>>
+class PairingHeap
+{
+    struct Node;
+
+  public:
+    class Handle
+    {
+      public:
+        Handle() : m_node(nullptr) {}
+        inline bool operator==(const Handle& handle) const { return m_node == handle.m_node; }
+        inline bool operator!=(const Handle& handle) const { return m_node != handle.m_node; }
+
+      private:
+        friend class PairingHeap;
+        Handle(Node* node) : m_node(node) {}
+        Node* m_node;
+    };
+
+    PairingHeap(const Compare& compare = Compare());
+    PairingHeap(const PairingHeap& heap) = delete;
+    PairingHeap(PairingHeap&& heap) noexcept;
+    ~PairingHeap() { clear(); }
+
+    PairingHeap& operator=(const PairingHeap& heap) = delete;
+    PairingHeap& operator=(PairingHeap&& heap) noexcept;
+
+    // front() is the element pop() returns next
+    Type front() const;
+
+    inline bool empty() const { return (m_root == nullptr); }
+    inline size_t size() const { return m_size; }
+
+    // Returns a handle that can later change or erase the element
+    Handle push(const Type value);
+    Type pop();
+
+    // Move every element of heap into this one in O(1), leaving heap empty
+    void meld(PairingHeap& heap);
+
+    // Value of the element behind the handle
+    inline const Type& get(Handle handle) const { return handle.m_node->value; }
+
+    // Give an element a value that moves it towards the front, or not at all
+    void decrease_key(Handle handle, const Type value);
+
+    void erase(Handle handle);
+    void clear();
+
+  private:
+    struct Node
+    {
+        Type value;
+        Node* child;
+        Node* sibling;
+        // Parent for a first child, left sibling otherwise
+        Node* prev;
+
+        Node(const Type& value_) : value(value_), child(nullptr), sibling(nullptr), prev(nullptr) {}
+    };
+
+    // Make the root that goes down the first child of the other; both must be detached
+    Node* link(Node* first, Node* second);
+
+    // Detach a node that is not the root from its parent and siblings
+    void cut(Node* node);
+
+    // Merge a sibling list into one tree with the two-pass pairing
+    Node* combine(Node* first);
+
+    // Once empty, give back the blocks melds brought in so they don't pile up
+    inline void releaseMelded() {
+        if (m_size == 0 && m_melded) {
+            m_pool.release();
+            m_melded = false;
+        }
+    }
+
+    NodePool m_pool;
+    Node* m_root;
+    size_t m_size;
+    // Blocks were spliced in since the pool was last released
+    bool m_melded;
+    Compare m_compare;
+};
+
+template<typename Type, typename Compare>
+PairingHeap<Type, Compare>::PairingHeap(const Compare& compare)
+    : m_pool(sizeof(Node)), m_root(nullptr), m_size(0), m_melded(false), m_compare(compare) {}
+
+template<typename Type, typename Compare>
+PairingHeap<Type, Compare>::PairingHeap(PairingHeap&& heap) noexcept
+    : m_pool(std::move(heap.m_pool)), m_root(heap.m_root), m_size(heap.m_size), m_melded(heap.m_melded),
+      m_compare(std::move(heap.m_compare)) {
+    heap.m_root = nullptr;
+    heap.m_size = 0;
+    heap.m_melded = false;
+}
+
+template<typename Type, typename Compare>
+PairingHeap<Type, Compare>& PairingHeap<Type, Compare>::operator=(PairingHeap&& heap) noexcept {
+    if (this != &heap) {
+        clear();
+        m_pool = std::move(heap.m_pool);
+        m_root = heap.m_root;
+        m_size = heap.m_size;
+        m_melded = heap.m_melded;
+        m_compare = std::move(heap.m_compare);
+        heap.m_root = nullptr;
+        heap.m_size = 0;
+        heap.m_melded = false;
+    }
+    return *this;
+}
+
+template<typename Type, typename Compare>
+typename PairingHeap<Type, Compare>::Node* PairingHeap<Type, Compare>::link(Node* first, Node* second) {
+    if (first == nullptr) {
+        return second;
+    }
+    if (second == nullptr) {
+        return first;
+    }
+    if (m_compare(first->value, second->value)) {
+        std::swap(first, second);
+    }
+    second->sibling = first->child;
+    if (first->child != nullptr) {
+        first->child->prev = second;
+    }
+    second->prev = first;
+    first->child = second;
+    return first;
+}
+
+template<typename Type, typename Compare>
+void PairingHeap<Type, Compare>::cut(Node* node) {
+    if (node->prev->child == node) {
+        node->prev->child = node->sibling;
+    } else {
+        node->prev->sibling = node->sibling;
+    }
+    if (node->sibling != nullptr) {
+        node->sibling->prev = node->prev;
+    }
+    node->sibling = node->prev = nullptr;
+}
+
+template<typename Type, typename Compare>
+typename PairingHeap<Type, Compare>::Node* PairingHeap<Type, Compare>::combine(Node* first) {
+    // First pass: link pairs left to right, stacking the results through sibling
+    Node* pairs = nullptr;
+    while (first != nullptr) {
+        Node* second = first->sibling;
+        Node* next = (second == nullptr) ? nullptr : second->sibling;
+        first->sibling = first->prev = nullptr;
+        if (second != nullptr) {
+            second->sibling = second->prev = nullptr;
+        }
+        Node* pair = link(first, second);
+        pair->sibling = pairs;
+        pairs = pair;
+        first = next;
+    }
+    // Second pass: fold the pairs right to left
+    Node* root = nullptr;
+    while (pairs != nullptr) {
+        Node* next = pairs->sibling;
+        pairs->sibling = nullptr;
+        root = link(root, pairs);
+        pairs = next;
+    }
+    return root;
+}
+
+template<typename Type, typename Compare>
+typename PairingHeap<Type, Compare>::Handle PairingHeap<Type, Compare>::push(const Type value) {
+    Node* node = m_pool.create<Node>(value);
+    m_root = link(m_root, node);
+    m_size++;
+    return Handle(node);
+}
+
+template<typename Type, typename Compare>
+Type PairingHeap<Type, Compare>::front() const {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("PairingHeap is empty.");
+#endif// _DEBUG
+        return Type();
+    }
+    return m_root->value;
+}
+
+template<typename Type, typename Compare>
+Type PairingHeap<Type, Compare>::pop() {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("PairingHeap is empty.");
+#endif// _DEBUG
+        return Type();
+    }
+    Node* root = m_root;
+    Type returnValue = std::move(root->value);
+    m_root = combine(root->child);
+    m_pool.destroy(root);
+    m_size--;
+    releaseMelded();
+    return returnValue;
+}
+
+template<typename Type, typename Compare>
+void PairingHeap<Type, Compare>::meld(PairingHeap& heap) {
+    if (&heap == this || heap.empty()) {
+        return;
+    }
+    m_pool.splice(heap.m_pool);
+    m_melded = true;
+    m_root = link(m_root, heap.m_root);
+    m_size += heap.m_size;
+    heap.m_root = nullptr;
+    heap.m_size = 0;
+}
+
+template<typename Type, typename Compare>
+void PairingHeap<Type, Compare>::decrease_key(Handle handle, const Type value) {
+    Node* node = handle.m_node;
+    if (m_compare(value, node->value)) {
+#ifdef _DEBUG
+        throw std::invalid_argument("decrease_key would move the element away from the front.");
+#endif// _DEBUG
+        // Moving away from the front: detach the node from its children and sift it in again
+        if (node == m_root) {
+            m_root = combine(node->child);
+        } else {
+            cut(node);
+            m_root = link(m_root, combine(node->child));
+        }
+        node->child = nullptr;
+        node->value = value;
+        m_root = link(m_root, node);
+        return;
+    }
+    node->value = value;
+    if (node != m_root) {
+        cut(node);
+        m_root = link(m_root, node);
+    }
+}
+
+template<typename Type, typename Compare>
+void PairingHeap<Type, Compare>::erase(Handle handle) {
+    Node* node = handle.m_node;
+    if (node == m_root) {
+        pop();
+        return;
+    }
+    cut(node);
+    m_root = link(m_root, combine(node->child));
+    m_pool.destroy(node);
+    m_size--;
+    releaseMelded();
+}
+
+template<typename Type, typename Compare>
+void PairingHeap<Type, Compare>::clear() {
+    // Rotate children up into the sibling chain so the tree is freed without a stack
+    Node* node = m_root;
+    while (node != nullptr) {
+        if (node->child != nullptr) {
+            Node* child = node->child;
+            node->child = child->sibling;
+            child->sibling = node;
+            node = child;
+        } else {
+            Node* next = node->sibling;
+            m_pool.destroy(node);
+            node = next;
+        }
+    }
+    m_root = nullptr;
+    m_size = 0;
+    m_melded = false;
+    m_pool.release();
+}
+
+#endif
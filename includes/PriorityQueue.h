@@ -27,48 +27,350 @@
 #ifndef DS_PRIORITY_QUEUE_H
 #define DS_PRIORITY_QUEUE_H
 
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
 #include <stdexcept>
-#include "DoublyLinkedList.h"
+#include <utility>
+#include "Projection.h"
 
-/* Naive Implementation of PriorityQueue with DoublyLinkedList */
-template<typename Type>
-class PriorityQueue
+/* PriorityQueue as an array-backed binary heap.
+ * push and pop are O(log n), and pushing a range at least as large as the queue
+ * rebuilds the heap bottom-up in O(n). Every element owns a slot that records its
+ * position in the heap and a generation, so a Handle can find and erase its element
+ * in O(log n) and a handle to a popped element is detected in O(1).
+ * Elements are ordered by Compare applied to Projection(element), like
+ * std::priority_queue: the default std::less puts the largest key on top. Use
+ * PairFirst to queue (priority, payload) pairs without wrapping them. */
+template<typename Type, typename Compare = std::less<>, typename Projection = Identity>
+class PriorityQueue : private FunctionHolder<Compare, 0>, private FunctionHolder<Projection, 1>
 {
   public:
-    PriorityQueue() { m_list.clear(); }
-    PriorityQueue(const PriorityQueue<Type>& llq) = delete;
+    typedef uint32_t Index;
+    static constexpr Index npos = UINT32_MAX;
+
+    struct Handle
+    {
+        Index index;
+        uint32_t generation;
+
+        Handle() : index(npos), generation(0) {}
+        Handle(Index index_, uint32_t generation_) : index(index_), generation(generation_) {}
+    };
+
+    PriorityQueue(const Compare& compare = Compare(), const Projection& projection = Projection());
+    PriorityQueue(Type values[], size_t size, const Compare& compare = Compare(),
+                  const Projection& projection = Projection());
+    PriorityQueue(std::initializer_list<Type> values, const Compare& compare = Compare(),
+                  const Projection& projection = Projection());
+    PriorityQueue(const PriorityQueue& pq) = delete;
     ~PriorityQueue() { clear(); }
 
-    // Don't need front() & back() methods
-    inline Type front() const { return m_list.getHead(); }
-    inline Type back() const { return m_list.getTail(); }
+    // front() is the element pop() returns next
+    Type front() const;
+
+    // Lowest priority element, a scan of the leaves in O(n)
+    Type back() const;
+
+    inline bool empty() const { return (m_size == 0); }
+    inline size_t size() const { return m_size; }
+    inline size_t capacity() const { return m_capacity; }
+
+    // Returns a handle that can later cancel the element
+    Handle push(const Type& value) { return emplace(value); }
+    Handle push(Type&& value) { return emplace(std::move(value)); }
 
-    inline bool empty() const { return m_list.empty(); }
+    // Construct the element from args and move it into the heap. The heap keeps
+    // default-constructed spare slots, so the element is move-assigned, never copied.
+    template<typename... Args>
+    Handle emplace(Args&&... args);
+
+    // Push count values without handles
+    void push_range(const Type* values, size_t count);
 
-    void push(const Type value);
     Type pop();
-    void clear() { m_list.clear(); }
+    void clear();
+
+    // Make room for count elements without growing
+    void reserve(size_t count);
+
+    // Check if the element behind the handle is still queued
+    bool contains(Handle handle) const;
+
+    // Remove a queued element. Returns false if it was already popped or erased.
+    bool erase(Handle handle);
 
   private:
-    DoublyLinkedList<Type> m_list;
+    struct Entry
+    {
+        Type value;
+        Index slot;
+    };
+
+    struct Slot
+    {
+        // Heap position while live, next free slot otherwise
+        Index position;
+        // Odd while the slot holds an element, bumped on every allocate and release
+        uint32_t generation;
+
+        Slot() : position(npos), generation(0) {}
+    };
+
+    // True if a goes below b
+    inline bool before(const Type& a, const Type& b) const {
+        const Projection& projection = FunctionHolder<Projection, 1>::function();
+        return FunctionHolder<Compare, 0>::function()(projection(a), projection(b));
+    }
+
+    void grow(size_t capacity);
+    Index allocate();
+    void release(Index slot);
+
+    // Put entry at pos and record the position in its slot
+    inline void place(size_t pos, Entry&& entry) {
+        m_slots[entry.slot].position = static_cast<Index>(pos);
+        m_heap[pos] = std::move(entry);
+    }
+
+    void siftUp(size_t pos);
+    void siftDown(size_t pos);
+
+    // Remove the entry at pos, filling the hole with the last entry
+    void removeAt(size_t pos);
+
+    std::unique_ptr<Entry[]> m_heap;
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_capacity;
+    size_t m_size;
+    // Slots at or above m_end have never been used
+    size_t m_end;
+    Index m_free;
 };
 
-template<typename Type>
-void PriorityQueue<Type>::push(const Type value) {
-    m_list.priorityInsert(value);
+template<typename Type, typename Compare, typename Projection>
+PriorityQueue<Type, Compare, Projection>::PriorityQueue(const Compare& compare, const Projection& projection)
+    : FunctionHolder<Compare, 0>(compare), FunctionHolder<Projection, 1>(projection),
+      m_capacity(0), m_size(0), m_end(0), m_free(npos) {}
+
+template<typename Type, typename Compare, typename Projection>
+PriorityQueue<Type, Compare, Projection>::PriorityQueue(Type values[], size_t size, const Compare& compare,
+                                                        const Projection& projection)
+    : PriorityQueue(compare, projection) {
+    push_range(values, size);
 }
 
-template<typename Type>
-Type PriorityQueue<Type>::pop() {
+template<typename Type, typename Compare, typename Projection>
+PriorityQueue<Type, Compare, Projection>::PriorityQueue(std::initializer_list<Type> values, const Compare& compare,
+                                                        const Projection& projection)
+    : PriorityQueue(compare, projection) {
+    push_range(values.begin(), values.size());
+}
+
+template<typename Type, typename Compare, typename Projection>
+void PriorityQueue<Type, Compare, Projection>::grow(size_t capacity) {
+    if (capacity > npos) {
+#ifdef _DEBUG
+        throw std::length_error("PriorityQueue cannot hold more than 2^32 - 1 elements.");
+#endif
+        capacity = npos;
+    }
+    std::unique_ptr<Entry[]> heap = std::make_unique<Entry[]>(capacity);
+    std::unique_ptr<Slot[]> slots = std::make_unique<Slot[]>(capacity);
+    for (size_t i = 0; i < m_size; i++) {
+        heap[i] = std::move(m_heap[i]);
+    }
+    for (size_t i = 0; i < m_end; i++) {
+        slots[i] = m_slots[i];
+    }
+    m_heap = std::move(heap);
+    m_slots = std::move(slots);
+    m_capacity = capacity;
+}
+
+template<typename Type, typename Compare, typename Projection>
+void PriorityQueue<Type, Compare, Projection>::reserve(size_t count) {
+    if (count > m_capacity) {
+        grow(count);
+    }
+}
+
+template<typename Type, typename Compare, typename Projection>
+typename PriorityQueue<Type, Compare, Projection>::Index PriorityQueue<Type, Compare, Projection>::allocate() {
+    Index slot;
+    if (m_free != npos) {
+        slot = m_free;
+        m_free = m_slots[slot].position;
+    } else {
+        // Every slot below m_end is live, so m_end == m_size < m_capacity
+        slot = static_cast<Index>(m_end++);
+    }
+    m_slots[slot].generation++;
+    return slot;
+}
+
+template<typename Type, typename Compare, typename Projection>
+void PriorityQueue<Type, Compare, Projection>::release(Index slot) {
+    m_slots[slot].generation++;
+    m_slots[slot].position = m_free;
+    m_free = slot;
+}
+
+template<typename Type, typename Compare, typename Projection>
+void PriorityQueue<Type, Compare, Projection>::siftUp(size_t pos) {
+    Entry entry = std::move(m_heap[pos]);
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        if (!before(m_heap[parent].value, entry.value)) {
+            break;
+        }
+        place(pos, std::move(m_heap[parent]));
+        pos = parent;
+    }
+    place(pos, std::move(entry));
+}
+
+template<typename Type, typename Compare, typename Projection>
+void PriorityQueue<Type, Compare, Projection>::siftDown(size_t pos) {
+    Entry entry = std::move(m_heap[pos]);
+    size_t child = 2 * pos + 1;
+    while (child < m_size) {
+        if (child + 1 < m_size && before(m_heap[child].value, m_heap[child + 1].value)) {
+            child++;
+        }
+        if (!before(entry.value, m_heap[child].value)) {
+            break;
+        }
+        place(pos, std::move(m_heap[child]));
+        pos = child;
+        child = 2 * pos + 1;
+    }
+    place(pos, std::move(entry));
+}
+
+template<typename Type, typename Compare, typename Projection>
+template<typename... Args>
+typename PriorityQueue<Type, Compare, Projection>::Handle PriorityQueue<Type, Compare, Projection>::emplace(Args&&... args) {
+    if (m_size == m_capacity) {
+        grow(m_capacity < 8 ? 8 : m_capacity * 2);
+    }
+    Index slot = allocate();
+    m_heap[m_size].value = Type(std::forward<Args>(args)...);
+    m_heap[m_size].slot = slot;
+    m_slots[slot].position = static_cast<Index>(m_size);
+    siftUp(m_size++);
+    return Handle(slot, m_slots[slot].generation);
+}
+
+template<typename Type, typename Compare, typename Projection>
+void PriorityQueue<Type, Compare, Projection>::push_range(const Type* values, size_t count) {
+    if (m_size + count > m_capacity) {
+        size_t capacity = m_capacity < 8 ? 8 : m_capacity * 2;
+        grow(capacity < m_size + count ? m_size + count : capacity);
+    }
+    size_t first = m_size;
+    for (size_t i = 0; i < count; i++) {
+        place(m_size++, Entry {values[i], allocate()});
+    }
+    if (count < first) {
+        for (size_t i = first; i < m_size; i++) {
+            siftUp(i);
+        }
+    } else {
+        // Floyd's heapify: sift down every parent from the last one up
+        for (size_t i = m_size / 2; i-- > 0;) {
+            siftDown(i);
+        }
+    }
+}
+
+template<typename Type, typename Compare, typename Projection>
+Type PriorityQueue<Type, Compare, Projection>::front() const {
     if (empty()) {
 #ifdef _DEBUG
         throw std::out_of_range("PriorityQueue is empty.");
 #endif// _DEBUG
         return Type();
     }
-    Type returnValue = m_list.getTail();
-    m_list.removeTail();
+    return m_heap[0].value;
+}
+
+template<typename Type, typename Compare, typename Projection>
+Type PriorityQueue<Type, Compare, Projection>::back() const {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("PriorityQueue is empty.");
+#endif// _DEBUG
+        return Type();
+    }
+    size_t lowest = m_size / 2;
+    for (size_t i = lowest + 1; i < m_size; i++) {
+        if (before(m_heap[i].value, m_heap[lowest].value)) {
+            lowest = i;
+        }
+    }
+    return m_heap[lowest].value;
+}
+
+template<typename Type, typename Compare, typename Projection>
+void PriorityQueue<Type, Compare, Projection>::removeAt(size_t pos) {
+    release(m_heap[pos].slot);
+    m_size--;
+    if (pos == m_size) {
+        m_heap[pos].value = Type();
+        return;
+    }
+    place(pos, std::move(m_heap[m_size]));
+    m_heap[m_size].value = Type();
+    if (pos > 0 && before(m_heap[(pos - 1) / 2].value, m_heap[pos].value)) {
+        siftUp(pos);
+    } else {
+        siftDown(pos);
+    }
+}
+
+template<typename Type, typename Compare, typename Projection>
+Type PriorityQueue<Type, Compare, Projection>::pop() {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("PriorityQueue is empty.");
+#endif// _DEBUG
+        return Type();
+    }
+    Type returnValue = std::move(m_heap[0].value);
+    removeAt(0);
     return returnValue;
 }
 
+template<typename Type, typename Compare, typename Projection>
+void PriorityQueue<Type, Compare, Projection>::clear() {
+    // Release the slots rather than forgetting them so outstanding handles stay stale
+    for (size_t i = 0; i < m_size; i++) {
+        release(m_heap[i].slot);
+        m_heap[i].value = Type();
+    }
+    m_size = 0;
+}
+
+template<typename Type, typename Compare, typename Projection>
+bool PriorityQueue<Type, Compare, Projection>::contains(Handle handle) const {
+    return handle.index < m_end && m_slots[handle.index].generation == handle.generation && (handle.generation & 1) == 1;
+}
+
+template<typename Type, typename Compare, typename Projection>
+bool PriorityQueue<Type, Compare, Projection>::erase(Handle handle) {
+    if (!contains(handle)) {
+        return false;
+    }
+    removeAt(m_slots[handle.index].position);
+    return true;
+}
+
+template<typename Type, typename Projection = Identity>
+using MaxHeap = PriorityQueue<Type, std::less<>, Projection>;
+
+template<typename Type, typename Projection = Identity>
+using MinHeap = PriorityQueue<Type, std::greater<>, Projection>;
+
 #endif
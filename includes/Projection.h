@@ -0,0 +1,75 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_PROJECTION_H
+#define DS_PROJECTION_H
+
+#include <type_traits>
+#include <utility>
+
+// Projections turn a stored value into the key a container orders it by
+
+// The value is its own key
+struct Identity
+{
+    template<typename Type>
+    constexpr const Type& operator()(const Type& value) const {
+        return value;
+    }
+};
+
+// Key a std::pair (or any type with a first member) by its first member
+struct PairFirst
+{
+    template<typename Pair>
+    constexpr const decltype(std::declval<const Pair&>().first)& operator()(const Pair& pair) const {
+        return pair.first;
+    }
+};
+
+/* Stores a function object (comparator, projection, hash) for a container to derive from.
+ * A stateless one becomes an empty base and takes no space; Tag tells two holders of
+ * the same type apart. Function pointers and final classes are stored as members. */
+template<typename Function, int Tag, bool Empty = std::is_empty<Function>::value && !std::is_final<Function>::value>
+class FunctionHolder
+{
+  public:
+    FunctionHolder(const Function& function) : m_function(function) {}
+    inline const Function& function() const { return m_function; }
+
+  private:
+    Function m_function;
+};
+
+template<typename Function, int Tag>
+class FunctionHolder<Function, Tag, true> : private Function
+{
+  public:
+    FunctionHolder(const Function& function) : Function(function) {}
+    inline const Function& function() const { return *this; }
+};
+
+#endif
@@ -28,6 +28,7 @@
 #define DS_QUEUE_H
 
 #include <initializer_list>
+#include "NodePool.h"
 
 template<typename Type>
 class Queue
@@ -35,11 +36,15 @@ class Queue
   public:
     class Node;
 
-    Queue() : m_front(nullptr), m_rear(nullptr), m_size(0) {}
-    Queue(const Queue<Type>& queue) : m_front(queue.m_front), m_rear(queue.m_rear), m_size(queue.m_size) {}
+    Queue() : m_front(nullptr), m_rear(nullptr), m_size(0), m_pool(sizeof(Node)) {}
+    Queue(const Queue<Type>& queue);
+    Queue(Queue<Type>&& queue) noexcept;
     Queue(std::initializer_list<Type> values);
     ~Queue();
 
+    Queue<Type>& operator=(const Queue<Type>& queue);
+    Queue<Type>& operator=(Queue<Type>&& queue) noexcept;
+
     /* Get the first element */
     inline Type front() const { return m_front->value; }
 
@@ -62,9 +67,13 @@ class Queue
     void clear();
 
   private:
+    // Replace the contents with a copy of queue, front to rear, fixing up prev and m_rear as it goes
+    void copyFrom(const Queue<Type>& queue);
+
     Node* m_front;
     Node* m_rear;
     size_t m_size;
+    NodePool m_pool;
 };
 
 template<typename Type>
@@ -78,10 +87,24 @@ class Queue<Type>::Node
     Node(Type value_, Node* next_ = nullptr, Node* prev_ = nullptr) : value(value_), next(next_), prev(prev_) {}
 
     friend class Queue<Type>;
+    friend class NodePool;
 };
 
 template<typename Type>
-Queue<Type>::Queue(std::initializer_list<Type> values) {
+Queue<Type>::Queue(const Queue<Type>& queue) : m_front(nullptr), m_rear(nullptr), m_size(0), m_pool(sizeof(Node)) {
+    copyFrom(queue);
+}
+
+template<typename Type>
+Queue<Type>::Queue(Queue<Type>&& queue) noexcept
+    : m_front(queue.m_front), m_rear(queue.m_rear), m_size(queue.m_size), m_pool(std::move(queue.m_pool)) {
+    queue.m_front = nullptr;
+    queue.m_rear = nullptr;
+    queue.m_size = 0;
+}
+
+template<typename Type>
+Queue<Type>::Queue(std::initializer_list<Type> values) : m_pool(sizeof(Node)) {
     m_size = 0;
     m_front = nullptr;
     m_rear = nullptr;
@@ -101,15 +124,53 @@ Queue<Type>::~Queue() {
     clear();
 }
 
+template<typename Type>
+Queue<Type>& Queue<Type>::operator=(const Queue<Type>& queue) {
+    if (this != &queue) {
+        copyFrom(queue);
+    }
+    return *this;
+}
+
+template<typename Type>
+Queue<Type>& Queue<Type>::operator=(Queue<Type>&& queue) noexcept {
+    if (this != &queue) {
+        clear();
+        m_front = queue.m_front;
+        m_rear = queue.m_rear;
+        m_size = queue.m_size;
+        m_pool = std::move(queue.m_pool);
+        queue.m_front = nullptr;
+        queue.m_rear = nullptr;
+        queue.m_size = 0;
+    }
+    return *this;
+}
+
+template<typename Type>
+void Queue<Type>::copyFrom(const Queue<Type>& queue) {
+    clear();
+    m_pool.reserve(queue.m_size);
+    Node* prev = nullptr;
+    Node** link = &m_front;
+    for (const Node* current = queue.m_front; current != nullptr; current = current->next) {
+        *link = m_pool.create<Node>(current->value, nullptr, prev);
+        prev = *link;
+        link = &prev->next;
+    }
+    m_rear = prev;
+    m_size = queue.m_size;
+}
+
 template<typename Type>
 void Queue<Type>::push(const Type value) {
     if (m_front == nullptr) {
-        Node* newNode = new Node(value);
+        Node* newNode = m_pool.create<Node>(value);
         m_front = newNode;
         m_rear = newNode;
         m_size = 1;
     } else {
-        Node* newNode = new Node(value, nullptr, m_rear);
+        Node* newNode = m_pool.create<Node>(value, nullptr, m_rear);
         m_rear->next = newNode;
         m_rear = newNode;
         m_size++;
@@ -126,14 +187,14 @@ Type Queue<Type>::pop() {
         m_rear = nullptr;
         m_size = 0;
         Type val = toDelete->value;
-        delete toDelete;
+        m_pool.destroy(toDelete);
         return val;
     } else {
         Node* toDelete = m_front;
         Type val = m_front->value;
         m_front = m_front->next;
         m_size--;
-        delete toDelete;
+        m_pool.destroy(toDelete);
         return val;
     }
 }
@@ -143,6 +204,7 @@ void Queue<Type>::clear() {
     while (m_size > 0) {
         pop();
     }
+    m_pool.release();
 }
 
 #endif
@@ -0,0 +1,311 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_RADIX_HEAP_H
+#define DS_RADIX_HEAP_H
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#include "Deque.h"
+#include "Projection.h"
+
+/* Monotone min-priority queue for unsigned integer keys (Ahuja, Mehlhorn, Orlin, Tarjan).
+ * Bucket 0 holds the values whose key equals the last extracted minimum and bucket b
+ * those whose key first differs from it in bit b - 1. When bucket 0 runs dry, the
+ * first non-empty bucket is split into lower ones around its minimum, so every value
+ * moves down at most once per bit: push is O(1) and pop amortized O(log C) with C the
+ * largest key, without a single key comparison between values.
+ * Keys are monotone: a pushed key must not be below the last key popped or returned by
+ * frontKey(), as in Dijkstra's algorithm and event simulation. The key of a value is
+ * Projection(value); use PairFirst to queue (key, payload) pairs. */
+template<typename Type, typename Projection = Identity>
+class RadixHeap
+{
+  public:
+    typedef typename std::decay<decltype(std::declval<Projection>()(std::declval<const Type&>()))>::type Key;
+    static_assert(std::is_unsigned<Key>::value, "RadixHeap keys must be unsigned integers");
+
+    RadixHeap(const Projection& projection = Projection());
+    RadixHeap(const RadixHeap& heap) = delete;
+
+    RadixHeap& operator=(const RadixHeap& heap) = delete;
+
+    inline bool empty() const { return (m_size == 0); }
+    inline size_t size() const { return m_size; }
+
+    // Smallest key, the key of the value pop() returns next
+    Key frontKey() const;
+    Type front() const;
+
+    void push(const Type& value);
+    Type pop();
+
+    void clear();
+
+  private:
+    static constexpr size_t bits = std::numeric_limits<Key>::digits;
+
+    // Bucket of key relative to the last extracted minimum
+    inline size_t bucketOf(Key key) const { return (key == m_last) ? 0 : bitWidth(static_cast<uint64_t>(key ^ m_last)); }
+
+    // Number of bits needed for a non-zero n
+    static size_t bitWidth(uint64_t n);
+
+    // Split the first non-empty bucket so bucket 0 holds the minimum; buckets must not be empty
+    void refill() const;
+
+    mutable Deque<Type> m_buckets[bits + 1];
+    mutable Key m_last;
+    size_t m_size;
+    Projection m_projection;
+};
+
+template<typename Type, typename Projection>
+RadixHeap<Type, Projection>::RadixHeap(const Projection& projection)
+    : m_last(0), m_size(0), m_projection(projection) {}
+
+template<typename Type, typename Projection>
+size_t RadixHeap<Type, Projection>::bitWidth(uint64_t n) {
+#if defined(_MSC_VER)
+    unsigned long bit;
+    _BitScanReverse64(&bit, n);
+    return bit + 1;
+#else
+    return 64 - __builtin_clzll(n);
+#endif
+}
+
+template<typename Type, typename Projection>
+void RadixHeap<Type, Projection>::refill() const {
+    size_t bucket = 1;
+    while (m_buckets[bucket].empty()) {
+        bucket++;
+    }
+    Deque<Type>& source = m_buckets[bucket];
+    Key smallest = m_projection(source[0]);
+    for (size_t i = 1; i < source.size(); i++) {
+        Key key = m_projection(source[i]);
+        if (key < smallest) {
+            smallest = key;
+        }
+    }
+    // Every key of the bucket shares its bits above bucket - 1 with smallest, so they all land lower
+    m_last = smallest;
+    while (!source.empty()) {
+        Type value = source.pop_back();
+        m_buckets[bucketOf(m_projection(value))].push_back(std::move(value));
+    }
+}
+
+template<typename Type, typename Projection>
+void RadixHeap<Type, Projection>::push(const Type& value) {
+    Key key = m_projection(value);
+    if (key < m_last) {
+#ifdef _DEBUG
+        throw std::invalid_argument("RadixHeap key is below the last extracted minimum.");
+#endif// _DEBUG
+        key = m_last;
+    }
+    m_buckets[bucketOf(key)].push_back(value);
+    m_size++;
+}
+
+template<typename Type, typename Projection>
+typename RadixHeap<Type, Projection>::Key RadixHeap<Type, Projection>::frontKey() const {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("RadixHeap is empty.");
+#endif// _DEBUG
+        return Key();
+    }
+    if (m_buckets[0].empty()) {
+        refill();
+    }
+    return m_last;
+}
+
+template<typename Type, typename Projection>
+Type RadixHeap<Type, Projection>::front() const {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("RadixHeap is empty.");
+#endif// _DEBUG
+        return Type();
+    }
+    if (m_buckets[0].empty()) {
+        refill();
+    }
+    return m_buckets[0].back();
+}
+
+template<typename Type, typename Projection>
+Type RadixHeap<Type, Projection>::pop() {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("RadixHeap is empty.");
+#endif// _DEBUG
+        return Type();
+    }
+    if (m_buckets[0].empty()) {
+        refill();
+    }
+    m_size--;
+    return m_buckets[0].pop_back();
+}
+
+template<typename Type, typename Projection>
+void RadixHeap<Type, Projection>::clear() {
+    for (size_t i = 0; i <= bits; i++) {
+        m_buckets[i].clear();
+    }
+    m_last = 0;
+    m_size = 0;
+}
+
+/* Min-priority queue for small unsigned integer keys in [0, range) (Dial).
+ * One bucket per key and a cursor at the smallest key that may be queued: push is O(1)
+ * and pop moves the cursor up to the next non-empty bucket. Keys need not be monotone,
+ * but with monotone keys the cursor only moves forward and a whole run costs
+ * O(n + range). The key of a value is Projection(value). */
+template<typename Type, typename Projection = Identity>
+class BucketQueue
+{
+  public:
+    typedef typename std::decay<decltype(std::declval<Projection>()(std::declval<const Type&>()))>::type Key;
+    static_assert(std::is_unsigned<Key>::value, "BucketQueue keys must be unsigned integers");
+
+    BucketQueue(size_t range, const Projection& projection = Projection());
+    BucketQueue(const BucketQueue& queue) = delete;
+
+    BucketQueue& operator=(const BucketQueue& queue) = delete;
+
+    inline bool empty() const { return (m_size == 0); }
+    inline size_t size() const { return m_size; }
+    inline size_t range() const { return m_range; }
+
+    // Smallest key, the key of the value pop() returns next
+    Key frontKey() const;
+    Type front() const;
+
+    void push(const Type& value);
+    Type pop();
+
+    void clear();
+
+  private:
+    // Move the cursor to the first non-empty bucket; the queue must not be empty
+    void advance() const;
+
+    std::unique_ptr<Deque<Type>[]> m_buckets;
+    size_t m_range;
+    mutable size_t m_cursor;
+    size_t m_size;
+    Projection m_projection;
+};
+
+template<typename Type, typename Projection>
+BucketQueue<Type, Projection>::BucketQueue(size_t range, const Projection& projection)
+    : m_buckets(std::make_unique<Deque<Type>[]>(range == 0 ? 1 : range)), m_range(range == 0 ? 1 : range),
+      m_cursor(0), m_size(0), m_projection(projection) {}
+
+template<typename Type, typename Projection>
+void BucketQueue<Type, Projection>::advance() const {
+    while (m_buckets[m_cursor].empty()) {
+        m_cursor++;
+    }
+}
+
+template<typename Type, typename Projection>
+void BucketQueue<Type, Projection>::push(const Type& value) {
+    size_t key = static_cast<size_t>(m_projection(value));
+    if (key >= m_range) {
+#ifdef _DEBUG
+        throw std::out_of_range("BucketQueue key is out of range.");
+#endif// _DEBUG
+        key = m_range - 1;
+    }
+    m_buckets[key].push_back(value);
+    if (key < m_cursor) {
+        m_cursor = key;
+    }
+    m_size++;
+}
+
+template<typename Type, typename Projection>
+typename BucketQueue<Type, Projection>::Key BucketQueue<Type, Projection>::frontKey() const {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("BucketQueue is empty.");
+#endif// _DEBUG
+        return Key();
+    }
+    advance();
+    return static_cast<Key>(m_cursor);
+}
+
+template<typename Type, typename Projection>
+Type BucketQueue<Type, Projection>::front() const {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("BucketQueue is empty.");
+#endif// _DEBUG
+        return Type();
+    }
+    advance();
+    return m_buckets[m_cursor].back();
+}
+
+template<typename Type, typename Projection>
+Type BucketQueue<Type, Projection>::pop() {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("BucketQueue is empty.");
+#endif// _DEBUG
+        return Type();
+    }
+    advance();
+    m_size--;
+    return m_buckets[m_cursor].pop_back();
+}
+
+template<typename Type, typename Projection>
+void BucketQueue<Type, Projection>::clear() {
+    for (size_t i = m_cursor; i < m_range && m_size > 0; i++) {
+        m_size -= m_buckets[i].size();
+        m_buckets[i].clear();
+    }
+    m_cursor = 0;
+    m_size = 0;
+}
+
+#endif
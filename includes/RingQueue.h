@@ -0,0 +1,283 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_RING_QUEUE_H
+#define DS_RING_QUEUE_H
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/* Growable ring buffer implementation of Queue.
+ * Capacity is a power of two and doubles when full; push and pop are amortized O(1). */
+template<typename Type>
+class RingQueue
+{
+  public:
+    RingQueue(size_t capacity = 0);
+    RingQueue(const RingQueue<Type>& queue);
+    RingQueue(RingQueue<Type>&& queue) noexcept;
+    ~RingQueue() = default;
+
+    RingQueue<Type>& operator=(const RingQueue<Type>& queue);
+    RingQueue<Type>& operator=(RingQueue<Type>&& queue) noexcept;
+
+    inline bool empty() const { return (m_head == m_tail); }
+    inline size_t size() const { return (m_tail - m_head); }
+    inline size_t capacity() const { return m_mask + 1; }
+
+    Type front() const;
+    Type back() const;
+
+    void push(Type value);
+    Type pop();
+    void clear();
+
+    // Make room for count elements without growing
+    void reserve(size_t count);
+
+    // Push count values in order, copying at most two contiguous segments
+    void push_range(const Type* values, size_t count);
+
+    // Pop up to count values into out, moving at most two contiguous segments.
+    // Returns the number popped.
+    size_t pop_range(Type* out, size_t count);
+
+  private:
+    // Copy with memcpy when Type allows it
+    static void copy(Type* dest, const Type* src, size_t count);
+
+    // Move with memcpy when Type allows it, leaving src moved-from
+    static void move(Type* dest, Type* src, size_t count);
+
+    // Copy the count elements starting at head out of the ring into dest
+    void unwrap(Type* dest, size_t count) const;
+
+    // Move the count elements starting at head out of the ring into dest
+    void drain(Type* dest, size_t count);
+
+    // Reset the count slots starting at head to Type() so they drop what they hold
+    void release(size_t count);
+
+    std::unique_ptr<Type[]> m_data;
+    size_t m_mask;
+    size_t m_head;
+    size_t m_tail;
+};
+
+template<typename Type>
+RingQueue<Type>::RingQueue(size_t capacity) : m_data(nullptr), m_mask(size_t(-1)), m_head(0), m_tail(0) {
+    reserve(capacity);
+}
+
+template<typename Type>
+RingQueue<Type>::RingQueue(const RingQueue<Type>& queue) : RingQueue(queue.size()) {
+    queue.unwrap(m_data.get(), queue.size());
+    m_tail = queue.size();
+}
+
+template<typename Type>
+RingQueue<Type>::RingQueue(RingQueue<Type>&& queue) noexcept
+    : m_data(std::move(queue.m_data)), m_mask(queue.m_mask), m_head(queue.m_head), m_tail(queue.m_tail) {
+    queue.m_mask = size_t(-1);
+    queue.m_head = queue.m_tail = 0;
+}
+
+template<typename Type>
+RingQueue<Type>& RingQueue<Type>::operator=(const RingQueue<Type>& queue) {
+    if (this != &queue) {
+        clear();
+        reserve(queue.size());
+        queue.unwrap(m_data.get(), queue.size());
+        m_tail = queue.size();
+    }
+    return *this;
+}
+
+template<typename Type>
+RingQueue<Type>& RingQueue<Type>::operator=(RingQueue<Type>&& queue) noexcept {
+    if (this != &queue) {
+        m_data = std::move(queue.m_data);
+        m_mask = queue.m_mask;
+        m_head = queue.m_head;
+        m_tail = queue.m_tail;
+        queue.m_mask = size_t(-1);
+        queue.m_head = queue.m_tail = 0;
+    }
+    return *this;
+}
+
+template<typename Type>
+void RingQueue<Type>::copy(Type* dest, const Type* src, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    if (std::is_trivially_copyable<Type>::value) {
+        std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(Type));
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            dest[i] = src[i];
+        }
+    }
+}
+
+template<typename Type>
+void RingQueue<Type>::move(Type* dest, Type* src, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    if (std::is_trivially_copyable<Type>::value) {
+        std::memcpy(static_cast<void*>(dest), static_cast<const void*>(src), count * sizeof(Type));
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            dest[i] = std::move(src[i]);
+        }
+    }
+}
+
+template<typename Type>
+void RingQueue<Type>::unwrap(Type* dest, size_t count) const {
+    size_t start = m_head & m_mask;
+    size_t first = (count < capacity() - start) ? count : capacity() - start;
+    copy(dest, m_data.get() + start, first);
+    copy(dest + first, m_data.get(), count - first);
+}
+
+template<typename Type>
+void RingQueue<Type>::drain(Type* dest, size_t count) {
+    size_t start = m_head & m_mask;
+    size_t first = (count < capacity() - start) ? count : capacity() - start;
+    move(dest, m_data.get() + start, first);
+    move(dest + first, m_data.get(), count - first);
+}
+
+template<typename Type>
+void RingQueue<Type>::release(size_t count) {
+    if (std::is_trivially_destructible<Type>::value) {
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        m_data[(m_head + i) & m_mask] = Type();
+    }
+}
+
+template<typename Type>
+void RingQueue<Type>::reserve(size_t count) {
+    if (m_data != nullptr && count <= capacity()) {
+        return;
+    }
+    size_t capacity = 8;
+    while (capacity < count) {
+        capacity *= 2;
+    }
+    std::unique_ptr<Type[]> data = std::make_unique<Type[]>(capacity);
+    size_t elements = size();
+    if (m_data != nullptr) {
+        drain(data.get(), elements);
+    }
+    m_data = std::move(data);
+    m_mask = capacity - 1;
+    m_head = 0;
+    m_tail = elements;
+}
+
+template<typename Type>
+Type RingQueue<Type>::front() const {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("RingQueue is empty.");
+#endif// _DEBUG
+        return Type();
+    }
+    return m_data[m_head & m_mask];
+}
+
+template<typename Type>
+Type RingQueue<Type>::back() const {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("RingQueue is empty.");
+#endif// _DEBUG
+        return Type();
+    }
+    return m_data[(m_tail - 1) & m_mask];
+}
+
+template<typename Type>
+void RingQueue<Type>::push(Type value) {
+    if (m_data == nullptr || size() == capacity()) {
+        reserve(size() + 1);
+    }
+    m_data[m_tail & m_mask] = std::move(value);
+    m_tail++;
+}
+
+template<typename Type>
+Type RingQueue<Type>::pop() {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("RingQueue is empty.");
+#endif// _DEBUG
+        return Type();
+    }
+    Type returnValue = std::move(m_data[m_head & m_mask]);
+    m_data[m_head & m_mask] = Type();
+    m_head++;
+    return returnValue;
+}
+
+template<typename Type>
+void RingQueue<Type>::clear() {
+    if (m_data != nullptr) {
+        release(size());
+    }
+    m_head = m_tail = 0;
+}
+
+template<typename Type>
+void RingQueue<Type>::push_range(const Type* values, size_t count) {
+    reserve(size() + count);
+    size_t start = m_tail & m_mask;
+    size_t first = (count < capacity() - start) ? count : capacity() - start;
+    copy(m_data.get() + start, values, first);
+    copy(m_data.get(), values + first, count - first);
+    m_tail += count;
+}
+
+template<typename Type>
+size_t RingQueue<Type>::pop_range(Type* out, size_t count) {
+    if (count > size()) {
+        count = size();
+    }
+    drain(out, count);
+    release(count);
+    m_head += count;
+    return count;
+}
+
+#endif
@@ -0,0 +1,220 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_SPSC_QUEUE_H
+#define DS_SPSC_QUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+/* Wait-free bounded queue for exactly one producer thread and one consumer thread.
+ * head and tail run freely over a power-of-two ring and sit on separate cache lines.
+ * Each side keeps a private copy of the other side's index and only reloads the
+ * shared one when the copy says the queue is full (or empty), so in steady state
+ * neither side touches the other's cache line. */
+template<typename Type>
+class SPSCQueue
+{
+  public:
+    SPSCQueue(size_t capacity = 1024);
+    SPSCQueue(const SPSCQueue<Type>& queue) = delete;
+
+    SPSCQueue<Type>& operator=(const SPSCQueue<Type>& queue) = delete;
+
+    inline size_t capacity() const { return m_mask + 1; }
+
+    // Approximate when called while the other side is running
+    inline size_t size() const { return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire); }
+    inline bool empty() const { return size() == 0; }
+
+    // Producer: returns false if the queue is full
+    bool try_push(const Type& value);
+
+    // Producer: push up to count values. Returns the number pushed.
+    size_t push_bulk(const Type* values, size_t count);
+
+    // Producer: get up to count contiguous slots that already hold objects; assign
+    // the new values into them, then commit(n). count is lowered to what is
+    // available; nullptr when the queue is full.
+    Type* try_reserve(size_t& count);
+
+    // Producer: publish the first count slots handed out by try_reserve
+    void commit(size_t count);
+
+    // Consumer: returns false if the queue is empty
+    bool try_pop(Type& value);
+
+    // Consumer: pop up to count values into out. Returns the number popped.
+    size_t pop_bulk(Type* out, size_t count);
+
+    // Consumer: get up to count contiguous values to read in place.
+    // count is lowered to what is available; nullptr when the queue is empty.
+    Type* try_peek(size_t& count);
+
+    // Consumer: drop the first count values handed out by try_peek
+    void consume(size_t count);
+
+  private:
+    static constexpr size_t cacheLine = 64;
+
+    // Free slots for the producer, refreshing the cached head only when needed
+    size_t writable(size_t wanted);
+
+    // Ready values for the consumer, refreshing the cached tail only when needed
+    size_t readable(size_t wanted);
+
+    alignas(cacheLine) std::atomic<size_t> m_tail;
+    size_t m_headCache;
+
+    alignas(cacheLine) std::atomic<size_t> m_head;
+    size_t m_tailCache;
+
+    alignas(cacheLine) std::unique_ptr<Type[]> m_data;
+    size_t m_mask;
+};
+
+template<typename Type>
+SPSCQueue<Type>::SPSCQueue(size_t capacity) : m_tail(0), m_headCache(0), m_head(0), m_tailCache(0) {
+    size_t rounded = 2;
+    while (rounded < capacity) {
+        rounded *= 2;
+    }
+    m_data = std::make_unique<Type[]>(rounded);
+    m_mask = rounded - 1;
+}
+
+template<typename Type>
+size_t SPSCQueue<Type>::writable(size_t wanted) {
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    size_t free = capacity() - (tail - m_headCache);
+    if (free < wanted) {
+        m_headCache = m_head.load(std::memory_order_acquire);
+        free = capacity() - (tail - m_headCache);
+    }
+    return free;
+}
+
+template<typename Type>
+size_t SPSCQueue<Type>::readable(size_t wanted) {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    size_t ready = m_tailCache - head;
+    if (ready < wanted) {
+        m_tailCache = m_tail.load(std::memory_order_acquire);
+        ready = m_tailCache - head;
+    }
+    return ready;
+}
+
+template<typename Type>
+bool SPSCQueue<Type>::try_push(const Type& value) {
+    if (writable(1) == 0) {
+        return false;
+    }
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    m_data[tail & m_mask] = value;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename Type>
+size_t SPSCQueue<Type>::push_bulk(const Type* values, size_t count) {
+    size_t free = writable(count);
+    if (count > free) {
+        count = free;
+    }
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; i++) {
+        m_data[(tail + i) & m_mask] = values[i];
+    }
+    m_tail.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+template<typename Type>
+Type* SPSCQueue<Type>::try_reserve(size_t& count) {
+    size_t free = writable(count);
+    size_t start = m_tail.load(std::memory_order_relaxed) & m_mask;
+    size_t contiguous = capacity() - start;
+    if (free < count) {
+        count = free;
+    }
+    if (contiguous < count) {
+        count = contiguous;
+    }
+    return (count == 0) ? nullptr : &m_data[start];
+}
+
+template<typename Type>
+void SPSCQueue<Type>::commit(size_t count) {
+    m_tail.store(m_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+}
+
+template<typename Type>
+bool SPSCQueue<Type>::try_pop(Type& value) {
+    if (readable(1) == 0) {
+        return false;
+    }
+    size_t head = m_head.load(std::memory_order_relaxed);
+    value = std::move(m_data[head & m_mask]);
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename Type>
+size_t SPSCQueue<Type>::pop_bulk(Type* out, size_t count) {
+    size_t ready = readable(count);
+    if (count > ready) {
+        count = ready;
+    }
+    size_t head = m_head.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; i++) {
+        out[i] = std::move(m_data[(head + i) & m_mask]);
+    }
+    m_head.store(head + count, std::memory_order_release);
+    return count;
+}
+
+template<typename Type>
+Type* SPSCQueue<Type>::try_peek(size_t& count) {
+    size_t ready = readable(count);
+    size_t start = m_head.load(std::memory_order_relaxed) & m_mask;
+    size_t contiguous = capacity() - start;
+    if (ready < count) {
+        count = ready;
+    }
+    if (contiguous < count) {
+        count = contiguous;
+    }
+    return (count == 0) ? nullptr : &m_data[start];
+}
+
+template<typename Type>
+void SPSCQueue<Type>::consume(size_t count) {
+    m_head.store(m_head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+}
+
+#endif
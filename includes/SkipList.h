@@ -0,0 +1,433 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_SKIP_LIST_H
+#define DS_SKIP_LIST_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <utility>
+#include "NodePool.h"
+
+/* Ordered map implemented as a SkipList.
+ * insert, erase, find and lowerBound are O(log n) expected.
+ * Nodes of each height come from their own NodePool, so a node only carries
+ * as many forward links as its level needs. */
+template<typename Key, typename Value, size_t MaxLevel = 16>
+class SkipListMap
+{
+  public:
+    class Node;
+    class Iterator;
+
+    SkipListMap();
+    SkipListMap(std::initializer_list<std::pair<Key, Value>> values);
+    SkipListMap(const SkipListMap<Key, Value, MaxLevel>& map) = delete;
+    ~SkipListMap() { clear(); }
+
+    inline bool empty() const { return (m_size == 0); }
+    inline size_t size() const { return m_size; }
+
+    // Insert a key or overwrite its value. Returns true if the key was new.
+    bool insert(const Key& key, const Value& value);
+
+    // Remove a key. Returns true if the key was present.
+    bool erase(const Key& key);
+
+    // Get a pointer to the value of key, nullptr if absent
+    Value* find(const Key& key);
+    const Value* find(const Key& key) const;
+    inline bool contains(const Key& key) const { return find(key) != nullptr; }
+
+    // Get the value of key, inserting a default value if absent
+    Value& operator[](const Key& key);
+
+    Iterator begin() const { return Iterator(m_head[0]); }
+    Iterator end() const { return Iterator(nullptr); }
+
+    // First element whose key is not less than key
+    Iterator lowerBound(const Key& key) const { return Iterator(findGreaterOrEqual(key, nullptr)); }
+
+    // Visit every (key, value) with from <= key < to in ascending order
+    template<typename Func>
+    void range(const Key& from, const Key& to, Func visit) const;
+
+    void clear();
+
+  private:
+    // Fill update[i] with the link at level i that precedes key
+    Node* findGreaterOrEqual(const Key& key, Node*** update) const;
+
+    // Link a new node after the predecessors findGreaterOrEqual recorded in update
+    Node* insertAt(Node** update[], const Key& key, const Value& value);
+    Node* createNode(const Key& key, const Value& value);
+    void destroyNode(Node* node);
+    size_t randomLevel();
+
+    Node* m_head[MaxLevel];
+    size_t m_level;
+    size_t m_size;
+    uint64_t m_seed;
+    NodePool m_pools[MaxLevel];
+};
+
+template<typename Key, typename Value, size_t MaxLevel>
+class SkipListMap<Key, Value, MaxLevel>::Node
+{
+  public:
+    const Key key;
+    Value value;
+
+    inline Node* nextNode() const { return next[0]; }
+
+  private:
+    Node(const Key& key_, const Value& value_, size_t level_)
+        : key(key_), value(value_), level(level_), next(reinterpret_cast<Node**>(reinterpret_cast<char*>(this) + sizeof(Node))) {
+        for (size_t i = 0; i < level; i++) {
+            next[i] = nullptr;
+        }
+    }
+
+    size_t level;
+    Node** next;
+
+    friend class SkipListMap<Key, Value, MaxLevel>;
+    friend class NodePool;
+};
+
+template<typename Key, typename Value, size_t MaxLevel>
+class SkipListMap<Key, Value, MaxLevel>::Iterator
+{
+  public:
+    Iterator(Node* node = nullptr) : m_node(node) {}
+
+    inline Node& operator*() const { return *m_node; }
+    inline Node* operator->() const { return m_node; }
+    inline Iterator& operator++() {
+        m_node = m_node->nextNode();
+        return *this;
+    }
+    inline bool operator==(const Iterator& it) const { return m_node == it.m_node; }
+    inline bool operator!=(const Iterator& it) const { return m_node != it.m_node; }
+
+  private:
+    Node* m_node;
+};
+
+template<typename Key, typename Value, size_t MaxLevel>
+SkipListMap<Key, Value, MaxLevel>::SkipListMap()
+    : m_level(1), m_size(0), m_seed(0x9E3779B97F4A7C15ULL) {
+    static_assert(MaxLevel > 0, "SkipListMap MaxLevel has to be positive non-zero integer");
+    for (size_t i = 0; i < MaxLevel; i++) {
+        m_head[i] = nullptr;
+        m_pools[i] = NodePool(sizeof(Node) + (i + 1) * sizeof(Node*));
+    }
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+SkipListMap<Key, Value, MaxLevel>::SkipListMap(std::initializer_list<std::pair<Key, Value>> values) : SkipListMap() {
+    for (auto& val : values) {
+        insert(val.first, val.second);
+    }
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+typename SkipListMap<Key, Value, MaxLevel>::Node* SkipListMap<Key, Value, MaxLevel>::findGreaterOrEqual(const Key& key, Node*** update) const {
+    Node* const* links = m_head;
+    for (size_t i = m_level; i-- > 0;) {
+        while (links[i] != nullptr && links[i]->key < key) {
+            links = links[i]->next;
+        }
+        if (update != nullptr) {
+            update[i] = const_cast<Node**>(links);
+        }
+    }
+    return links[0];
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+typename SkipListMap<Key, Value, MaxLevel>::Node* SkipListMap<Key, Value, MaxLevel>::createNode(const Key& key, const Value& value) {
+    size_t level = randomLevel();
+    return m_pools[level - 1].template create<Node>(key, value, level);
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+void SkipListMap<Key, Value, MaxLevel>::destroyNode(Node* node) {
+    m_pools[node->level - 1].destroy(node);
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+size_t SkipListMap<Key, Value, MaxLevel>::randomLevel() {
+    // xorshift64, each extra level with probability 1/4
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 7;
+    m_seed ^= m_seed << 17;
+    uint64_t bits = m_seed;
+    size_t level = 1;
+    while (level < MaxLevel && (bits & 3) == 0) {
+        level++;
+        bits >>= 2;
+    }
+    return level;
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+bool SkipListMap<Key, Value, MaxLevel>::insert(const Key& key, const Value& value) {
+    Node** update[MaxLevel];
+    Node* node = findGreaterOrEqual(key, update);
+    if (node != nullptr && !(key < node->key)) {
+        node->value = value;
+        return false;
+    }
+
+    insertAt(update, key, value);
+    return true;
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+typename SkipListMap<Key, Value, MaxLevel>::Node* SkipListMap<Key, Value, MaxLevel>::insertAt(Node** update[], const Key& key, const Value& value) {
+    Node* newNode = createNode(key, value);
+    for (size_t i = m_level; i < newNode->level; i++) {
+        update[i] = m_head;
+    }
+    if (newNode->level > m_level) {
+        m_level = newNode->level;
+    }
+    for (size_t i = 0; i < newNode->level; i++) {
+        newNode->next[i] = update[i][i];
+        update[i][i] = newNode;
+    }
+    m_size++;
+    return newNode;
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+bool SkipListMap<Key, Value, MaxLevel>::erase(const Key& key) {
+    Node** update[MaxLevel];
+    Node* node = findGreaterOrEqual(key, update);
+    if (node == nullptr || key < node->key) {
+        return false;
+    }
+    for (size_t i = 0; i < node->level; i++) {
+        update[i][i] = node->next[i];
+    }
+    while (m_level > 1 && m_head[m_level - 1] == nullptr) {
+        m_level--;
+    }
+    destroyNode(node);
+    m_size--;
+    return true;
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+Value* SkipListMap<Key, Value, MaxLevel>::find(const Key& key) {
+    Node* node = findGreaterOrEqual(key, nullptr);
+    if (node == nullptr || key < node->key) {
+        return nullptr;
+    }
+    return &node->value;
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+const Value* SkipListMap<Key, Value, MaxLevel>::find(const Key& key) const {
+    const Node* node = findGreaterOrEqual(key, nullptr);
+    if (node == nullptr || key < node->key) {
+        return nullptr;
+    }
+    return &node->value;
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+Value& SkipListMap<Key, Value, MaxLevel>::operator[](const Key& key) {
+    Node** update[MaxLevel];
+    Node* node = findGreaterOrEqual(key, update);
+    if (node == nullptr || key < node->key) {
+        node = insertAt(update, key, Value());
+    }
+    return node->value;
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+template<typename Func>
+void SkipListMap<Key, Value, MaxLevel>::range(const Key& from, const Key& to, Func visit) const {
+    for (Node* node = findGreaterOrEqual(from, nullptr); node != nullptr && node->key < to; node = node->next[0]) {
+        visit(node->key, node->value);
+    }
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+void SkipListMap<Key, Value, MaxLevel>::clear() {
+    Node* node = m_head[0];
+    while (node != nullptr) {
+        Node* next = node->next[0];
+        destroyNode(node);
+        node = next;
+    }
+    for (size_t i = 0; i < MaxLevel; i++) {
+        m_head[i] = nullptr;
+        m_pools[i].release();
+    }
+    m_level = 1;
+    m_size = 0;
+}
+
+/* Ordered set implemented as a SkipList */
+template<typename Key, size_t MaxLevel = 16>
+class SkipListSet
+{
+  public:
+    typedef typename SkipListMap<Key, bool, MaxLevel>::Iterator Iterator;
+
+    SkipListSet() {}
+    SkipListSet(std::initializer_list<Key> values);
+    SkipListSet(const SkipListSet<Key, MaxLevel>& set) = delete;
+    ~SkipListSet() { clear(); }
+
+    inline bool empty() const { return m_map.empty(); }
+    inline size_t size() const { return m_map.size(); }
+
+    // Returns true if the key was new
+    bool insert(const Key& key) { return m_map.insert(key, true); }
+    bool erase(const Key& key) { return m_map.erase(key); }
+    bool contains(const Key& key) const { return m_map.contains(key); }
+
+    Iterator begin() const { return m_map.begin(); }
+    Iterator end() const { return m_map.end(); }
+    Iterator lowerBound(const Key& key) const { return m_map.lowerBound(key); }
+
+    // Visit every key with from <= key < to in ascending order
+    template<typename Func>
+    void range(const Key& from, const Key& to, Func visit) const;
+
+    void clear() { m_map.clear(); }
+
+  private:
+    SkipListMap<Key, bool, MaxLevel> m_map;
+};
+
+template<typename Key, size_t MaxLevel>
+SkipListSet<Key, MaxLevel>::SkipListSet(std::initializer_list<Key> values) {
+    for (auto& val : values) {
+        insert(val);
+    }
+}
+
+template<typename Key, size_t MaxLevel>
+template<typename Func>
+void SkipListSet<Key, MaxLevel>::range(const Key& from, const Key& to, Func visit) const {
+    m_map.range(from, to, [&visit](const Key& key, const bool&) { visit(key); });
+}
+
+/* SkipListMap guarded by a reader-writer lock.
+ * Any number of find/contains/range calls run concurrently; insert and erase are exclusive.
+ * Values are copied out since references would outlive the lock. */
+template<typename Key, typename Value, size_t MaxLevel = 16>
+class ConcurrentSkipListMap
+{
+  public:
+    ConcurrentSkipListMap() {}
+    ConcurrentSkipListMap(const ConcurrentSkipListMap<Key, Value, MaxLevel>& map) = delete;
+    ~ConcurrentSkipListMap() { clear(); }
+
+    bool empty() const;
+    size_t size() const;
+
+    bool insert(const Key& key, const Value& value);
+    bool erase(const Key& key);
+
+    // Copy the value of key into value. Returns false if the key is absent.
+    bool find(const Key& key, Value& value) const;
+    bool contains(const Key& key) const;
+
+    // Visit every (key, value) with from <= key < to while holding the read lock
+    template<typename Func>
+    void range(const Key& from, const Key& to, Func visit) const;
+
+    void clear();
+
+  private:
+    SkipListMap<Key, Value, MaxLevel> m_map;
+    mutable std::shared_mutex m_mutex;
+};
+
+template<typename Key, typename Value, size_t MaxLevel>
+bool ConcurrentSkipListMap<Key, Value, MaxLevel>::empty() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_map.empty();
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+size_t ConcurrentSkipListMap<Key, Value, MaxLevel>::size() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_map.size();
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+bool ConcurrentSkipListMap<Key, Value, MaxLevel>::insert(const Key& key, const Value& value) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    return m_map.insert(key, value);
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+bool ConcurrentSkipListMap<Key, Value, MaxLevel>::erase(const Key& key) {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    return m_map.erase(key);
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+bool ConcurrentSkipListMap<Key, Value, MaxLevel>::find(const Key& key, Value& value) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    const Value* found = m_map.find(key);
+    if (found == nullptr) {
+        return false;
+    }
+    value = *found;
+    return true;
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+bool ConcurrentSkipListMap<Key, Value, MaxLevel>::contains(const Key& key) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_map.contains(key);
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+template<typename Func>
+void ConcurrentSkipListMap<Key, Value, MaxLevel>::range(const Key& from, const Key& to, Func visit) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    m_map.range(from, to, visit);
+}
+
+template<typename Key, typename Value, size_t MaxLevel>
+void ConcurrentSkipListMap<Key, Value, MaxLevel>::clear() {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_map.clear();
+}
+
+#endif
@@ -0,0 +1,302 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_SLIDING_WINDOW_H
+#define DS_SLIDING_WINDOW_H
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include "Deque.h"
+
+/* Windows are defined by a span over a Time stamp. push(value) stamps each value with
+ * the number of values pushed before it, so a span of n keeps the last n values;
+ * push(value, time) takes a caller supplied, non-decreasing time stamp instead, so a
+ * span of 1000 milliseconds keeps the values of the last second. After each push,
+ * values with a stamp at or before (time - span) expire. A span of 0 disables automatic
+ * expiry and the caller expires values with expire(before). */
+
+/* Sliding window minimum or maximum with a monotonic deque.
+ * Only values that can still become the extreme are kept, ordered from oldest to
+ * newest and from best to worst by Compare, so the extreme is always at the front.
+ * push, expire and front are all amortized O(1). */
+template<typename Type, typename Compare = std::less<Type>, typename Time = uint64_t>
+class MonotonicWindow
+{
+  public:
+    MonotonicWindow(Time span = 0, const Compare& compare = Compare())
+        : m_compare(compare), m_span(span), m_count(0) {}
+
+    inline bool empty() const { return m_candidates.empty(); }
+
+    // Number of values that can still become the extreme, not the window size
+    inline size_t candidates() const { return m_candidates.size(); }
+
+    // Values pushed since construction or the last clear
+    inline Time count() const { return m_count; }
+
+    // Extreme of the values in the window
+    Type front() const;
+
+    void push(const Type& value) { push(value, m_count); }
+    void push(const Type& value, Time time);
+
+    // Push count values in order; with a count window only the last span values are looked at
+    void push_range(const Type* values, size_t count);
+
+    // Push count values with their time stamps in order
+    void push_range(const Type* values, const Time* times, size_t count);
+
+    // Drop every value stamped before time
+    void expire(Time before);
+
+    void clear() {
+        m_candidates.clear();
+        m_count = 0;
+    }
+
+  private:
+    struct Entry
+    {
+        Type value;
+        Time time;
+    };
+
+    Deque<Entry> m_candidates;
+    Compare m_compare;
+    Time m_span;
+    Time m_count;
+};
+
+template<typename Type, typename Time = uint64_t>
+using SlidingMin = MonotonicWindow<Type, std::less<Type>, Time>;
+
+template<typename Type, typename Time = uint64_t>
+using SlidingMax = MonotonicWindow<Type, std::greater<Type>, Time>;
+
+template<typename Type, typename Compare, typename Time>
+Type MonotonicWindow<Type, Compare, Time>::front() const {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("Window is empty");
+#endif// _DEBUG
+        return Type();
+    }
+    return m_candidates[0].value;
+}
+
+template<typename Type, typename Compare, typename Time>
+void MonotonicWindow<Type, Compare, Time>::push(const Type& value, Time time) {
+    // Older values that are not better than the new one can never be the extreme again
+    while (!m_candidates.empty() && !m_compare(m_candidates[m_candidates.size() - 1].value, value)) {
+        m_candidates.pop_back();
+    }
+    m_candidates.push_back(Entry {value, time});
+    m_count++;
+    if (m_span != 0 && time >= m_span) {
+        expire(time - m_span + 1);
+    }
+}
+
+template<typename Type, typename Compare, typename Time>
+void MonotonicWindow<Type, Compare, Time>::push_range(const Type* values, size_t count) {
+    size_t first = 0;
+    if (m_span != 0 && count > m_span) {
+        // Everything before the last span values expires within this batch
+        first = count - static_cast<size_t>(m_span);
+        m_count += static_cast<Time>(first);
+    }
+    for (size_t i = first; i < count; i++) {
+        push(values[i], m_count);
+    }
+}
+
+template<typename Type, typename Compare, typename Time>
+void MonotonicWindow<Type, Compare, Time>::push_range(const Type* values, const Time* times, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        push(values[i], times[i]);
+    }
+}
+
+template<typename Type, typename Compare, typename Time>
+void MonotonicWindow<Type, Compare, Time>::expire(Time before) {
+    while (!m_candidates.empty() && m_candidates[0].time < before) {
+        m_candidates.pop_front();
+    }
+}
+
+/* Sliding window over any associative operation (sum, gcd, min with its position, ...)
+ * with two stacks. New values go on the back stack, which keeps a running aggregate;
+ * the front stack holds the oldest values with the aggregate of each value and
+ * everything newer than it in the stack. When the front stack runs out, the back stack
+ * is flipped onto it, so every value is combined a constant number of times and push,
+ * expire and aggregate are amortized O(1). Op need not be commutative or invertible. */
+template<typename Type, typename Op = std::plus<Type>, typename Time = uint64_t>
+class SlidingAggregate
+{
+  public:
+    SlidingAggregate(Time span = 0, const Op& op = Op()) : m_op(op), m_span(span), m_count(0) {}
+
+    inline bool empty() const { return m_front.empty() && m_back.empty(); }
+    inline size_t size() const { return m_front.size() + m_back.size(); }
+
+    // Values pushed since construction or the last clear
+    inline Time count() const { return m_count; }
+
+    // Op folded over the window from the oldest to the newest value
+    Type aggregate() const;
+
+    void push(const Type& value) { push(value, m_count); }
+    void push(const Type& value, Time time);
+
+    // Push count values in order; with a count window only the last span values are looked at
+    void push_range(const Type* values, size_t count);
+
+    // Push count values with their time stamps in order
+    void push_range(const Type* values, const Time* times, size_t count);
+
+    // Drop the oldest value
+    void pop();
+
+    // Drop every value stamped before time
+    void expire(Time before);
+
+    void clear();
+
+  private:
+    struct Entry
+    {
+        Type value;
+        Time time;
+        Type aggregate;
+    };
+
+    // Time stamp of the oldest value
+    Time oldest() const;
+
+    // Move the back stack onto the front stack, oldest value on top
+    void flip();
+
+    // The top of the front stack is its last element, the bottom of the back stack its first
+    Deque<Entry> m_front;
+    Deque<Entry> m_back;
+    Type m_backAggregate;
+    Op m_op;
+    Time m_span;
+    Time m_count;
+};
+
+template<typename Type, typename Op, typename Time>
+Type SlidingAggregate<Type, Op, Time>::aggregate() const {
+    if (m_front.empty()) {
+        if (m_back.empty()) {
+#ifdef _DEBUG
+            throw std::out_of_range("Window is empty");
+#endif// _DEBUG
+            return Type();
+        }
+        return m_backAggregate;
+    }
+    const Type& front = m_front[m_front.size() - 1].aggregate;
+    return m_back.empty() ? front : m_op(front, m_backAggregate);
+}
+
+template<typename Type, typename Op, typename Time>
+void SlidingAggregate<Type, Op, Time>::push(const Type& value, Time time) {
+    m_backAggregate = m_back.empty() ? value : m_op(m_backAggregate, value);
+    m_back.push_back(Entry {value, time, value});
+    m_count++;
+    if (m_span != 0 && time >= m_span) {
+        expire(time - m_span + 1);
+    }
+}
+
+template<typename Type, typename Op, typename Time>
+void SlidingAggregate<Type, Op, Time>::push_range(const Type* values, size_t count) {
+    size_t first = 0;
+    if (m_span != 0 && count > m_span) {
+        // Everything before the last span values expires within this batch
+        first = count - static_cast<size_t>(m_span);
+        m_count += static_cast<Time>(first);
+    }
+    for (size_t i = first; i < count; i++) {
+        push(values[i], m_count);
+    }
+}
+
+template<typename Type, typename Op, typename Time>
+void SlidingAggregate<Type, Op, Time>::push_range(const Type* values, const Time* times, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        push(values[i], times[i]);
+    }
+}
+
+template<typename Type, typename Op, typename Time>
+void SlidingAggregate<Type, Op, Time>::flip() {
+    while (!m_back.empty()) {
+        Entry entry = m_back.pop_back();
+        if (!m_front.empty()) {
+            entry.aggregate = m_op(entry.value, m_front[m_front.size() - 1].aggregate);
+        }
+        m_front.push_back(std::move(entry));
+    }
+}
+
+template<typename Type, typename Op, typename Time>
+Time SlidingAggregate<Type, Op, Time>::oldest() const {
+    return m_front.empty() ? m_back[0].time : m_front[m_front.size() - 1].time;
+}
+
+template<typename Type, typename Op, typename Time>
+void SlidingAggregate<Type, Op, Time>::pop() {
+    if (empty()) {
+#ifdef _DEBUG
+        throw std::out_of_range("Window is empty");
+#endif// _DEBUG
+        return;
+    }
+    if (m_front.empty()) {
+        flip();
+    }
+    m_front.pop_back();
+}
+
+template<typename Type, typename Op, typename Time>
+void SlidingAggregate<Type, Op, Time>::expire(Time before) {
+    while (!empty() && oldest() < before) {
+        pop();
+    }
+}
+
+template<typename Type, typename Op, typename Time>
+void SlidingAggregate<Type, Op, Time>::clear() {
+    m_front.clear();
+    m_back.clear();
+    m_count = 0;
+}
+
+#endif
@@ -28,6 +28,7 @@
 #define DS_STACK_H
 
 #include <stdexcept>
+#include "NodePool.h"
 
 // Implementation of Stack
 template<typename Type>
@@ -36,12 +37,14 @@ class Stack
   public:
     class Node;
 
-    Stack() : m_top(nullptr) {}
-    Stack(Node* top) : m_top(top) {}
+    Stack() : m_top(nullptr), m_pool(sizeof(Node)) {}
+    Stack(Node* top);
     Stack(const Stack<Type>& s);
+    Stack(Stack<Type>&& s) noexcept;
     ~Stack() { clear(); }
 
     Stack<Type>& operator=(const Stack<Type>& s);
+    Stack<Type>& operator=(Stack<Type>&& s) noexcept;
 
     // Check if the stack is empty
     inline bool empty() const { return (m_top == nullptr); }
@@ -59,7 +62,11 @@ class Stack
     void clear();
 
   private:
+    // Replace the contents with copies of the nodes starting at top, keeping top on top
+    void copyFrom(const Node* top);
+
     Node* m_top;
+    NodePool m_pool;
 };
 
 template<typename Type>
@@ -75,30 +82,61 @@ class Stack<Type>::Node
         : value(value_), next(next_) {}
 
     friend class Stack<Type>;
+    friend class NodePool;
 };
 
 template<typename Type>
-Stack<Type>::Stack(const Stack<Type>& s) {
-    if (s.m_top == nullptr) {
-        m_top = nullptr;
-    } else {
-        *m_top = *(s.m_top);
-    }
+Stack<Type>::Stack(Node* top) : m_top(nullptr), m_pool(sizeof(Node)) {
+    copyFrom(top);
+}
+
+template<typename Type>
+Stack<Type>::Stack(const Stack<Type>& s) : m_top(nullptr), m_pool(sizeof(Node)) {
+    copyFrom(s.m_top);
+}
+
+template<typename Type>
+Stack<Type>::Stack(Stack<Type>&& s) noexcept : m_top(s.m_top), m_pool(std::move(s.m_pool)) {
+    s.m_top = nullptr;
 }
 
 template<typename Type>
 Stack<Type>& Stack<Type>::operator=(const Stack<Type>& s) {
-    if (s.m_top == nullptr) {
-        m_top = nullptr;
-    } else {
-        *m_top = *(s.m_top);
+    if (this != &s) {
+        copyFrom(s.m_top);
+    }
+    return *this;
+}
+
+template<typename Type>
+Stack<Type>& Stack<Type>::operator=(Stack<Type>&& s) noexcept {
+    if (this != &s) {
+        clear();
+        m_top = s.m_top;
+        m_pool = std::move(s.m_pool);
+        s.m_top = nullptr;
     }
     return *this;
 }
 
+template<typename Type>
+void Stack<Type>::copyFrom(const Node* top) {
+    clear();
+    size_t count = 0;
+    for (const Node* current = top; current != nullptr; current = current->next) {
+        count++;
+    }
+    m_pool.reserve(count);
+    Node** link = &m_top;
+    for (const Node* current = top; current != nullptr; current = current->next) {
+        *link = m_pool.create<Node>(current->value);
+        link = &(*link)->next;
+    }
+}
+
 template<typename Type>
 void Stack<Type>::push(const Type value) {
-    m_top = new Node(value, m_top);
+    m_top = m_pool.create<Node>(value, m_top);
 }
 
 template<typename Type>
@@ -112,7 +150,7 @@ Type Stack<Type>::pop() {
     Node* temp = m_top;
     Type value = m_top->value;
     m_top = m_top->next;
-    delete temp;
+    m_pool.destroy(temp);
     return value;
 }
 
@@ -132,6 +170,7 @@ void Stack<Type>::clear() {
     while (m_top != nullptr) {
         pop();
     }
+    m_pool.release();
 }
 
 #endif
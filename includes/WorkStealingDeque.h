@@ -0,0 +1,176 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef DS_WORK_STEALING_DEQUE_H
+#define DS_WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+/* Lock-free work-stealing deque (Chase-Lev, with the memory orderings of Le et al.).
+ * A single owner thread pushes and pops at the bottom like a stack, while any number
+ * of thieves steal from the top. Only the last element is contended, so the owner's
+ * fast path has no CAS. The owner doubles the buffer when it is full; thieves may
+ * still be reading the old one, so retired buffers are kept until the deque is
+ * destroyed, which bounds them by the size of the current buffer.
+ * Type is stored in atomic cells and must be trivially copyable (usually a task pointer). */
+template<typename Type>
+class WorkStealingDeque
+{
+    static_assert(std::is_trivially_copyable<Type>::value, "WorkStealingDeque requires a trivially copyable Type");
+
+  public:
+    WorkStealingDeque(size_t capacity = 256);
+    WorkStealingDeque(const WorkStealingDeque<Type>& deque) = delete;
+    ~WorkStealingDeque() { delete m_buffer.load(std::memory_order_relaxed); }
+
+    WorkStealingDeque<Type>& operator=(const WorkStealingDeque<Type>& deque) = delete;
+
+    // Approximate while other threads are running
+    size_t size() const;
+    inline bool empty() const { return size() == 0; }
+    inline size_t capacity() const { return m_buffer.load(std::memory_order_relaxed)->capacity(); }
+
+    // Owner only: add a value at the bottom, growing the buffer when it is full
+    void push(const Type& value);
+
+    // Owner only: take the most recently pushed value. Returns false if the deque is empty.
+    bool pop(Type& value);
+
+    // Any thread: take the oldest value. Returns false if the deque is empty or
+    // another thread took the value first; a scheduler then moves to the next victim.
+    bool steal(Type& value);
+
+  private:
+    static constexpr size_t cacheLine = 64;
+
+    struct Buffer
+    {
+        Buffer(size_t capacity, Buffer* previous_)
+            : mask(capacity - 1), cells(std::make_unique<std::atomic<Type>[]>(capacity)), previous(previous_) {}
+
+        inline size_t capacity() const { return mask + 1; }
+        inline Type get(int64_t pos) const { return cells[static_cast<size_t>(pos) & mask].load(std::memory_order_relaxed); }
+        inline void put(int64_t pos, const Type& value) {
+            cells[static_cast<size_t>(pos) & mask].store(value, std::memory_order_relaxed);
+        }
+
+        size_t mask;
+        std::unique_ptr<std::atomic<Type>[]> cells;
+        std::unique_ptr<Buffer> previous;
+    };
+
+    // Owner only: move the live range [top, bottom) into a buffer twice the size
+    Buffer* grow(Buffer* buffer, int64_t top, int64_t bottom);
+
+    alignas(cacheLine) std::atomic<int64_t> m_top;
+    alignas(cacheLine) std::atomic<int64_t> m_bottom;
+    std::atomic<Buffer*> m_buffer;
+};
+
+template<typename Type>
+WorkStealingDeque<Type>::WorkStealingDeque(size_t capacity) : m_top(0), m_bottom(0) {
+    size_t rounded = 2;
+    while (rounded < capacity) {
+        rounded *= 2;
+    }
+    m_buffer.store(new Buffer(rounded, nullptr), std::memory_order_relaxed);
+}
+
+template<typename Type>
+size_t WorkStealingDeque<Type>::size() const {
+    int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    int64_t top = m_top.load(std::memory_order_relaxed);
+    return (bottom > top) ? static_cast<size_t>(bottom - top) : 0;
+}
+
+template<typename Type>
+typename WorkStealingDeque<Type>::Buffer* WorkStealingDeque<Type>::grow(Buffer* buffer, int64_t top, int64_t bottom) {
+    Buffer* grown = new Buffer(buffer->capacity() * 2, buffer);
+    for (int64_t i = top; i < bottom; i++) {
+        grown->put(i, buffer->get(i));
+    }
+    m_buffer.store(grown, std::memory_order_release);
+    return grown;
+}
+
+template<typename Type>
+void WorkStealingDeque<Type>::push(const Type& value) {
+    int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    int64_t top = m_top.load(std::memory_order_acquire);
+    Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+    if (bottom - top > static_cast<int64_t>(buffer->mask)) {
+        buffer = grow(buffer, top, bottom);
+    }
+    buffer->put(bottom, value);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+template<typename Type>
+bool WorkStealingDeque<Type>::pop(Type& value) {
+    int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+    m_bottom.store(bottom, std::memory_order_relaxed);
+    // Publish the reservation before reading top, pairing with the fence in steal
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = m_top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+    value = buffer->get(bottom);
+    if (top == bottom) {
+        // Last element: race the thieves for it
+        bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+template<typename Type>
+bool WorkStealingDeque<Type>::steal(Type& value) {
+    int64_t top = m_top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+    if (top >= bottom) {
+        return false;
+    }
+    Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+    Type stolen = buffer->get(top);
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return false;
+    }
+    value = stolen;
+    return true;
+}
+
+#endif
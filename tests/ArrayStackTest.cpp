@@ -0,0 +1,98 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ArrayStack.h"
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <string>
+#include <vector>
+
+static void make(int i, int& value) { value = i; }
+static void make(int i, std::string& value) { value = std::to_string(i); }
+
+// Without Spill, pushes past MaxSize are dropped (release builds) instead of stored
+template<typename Type, bool Spill>
+static void testDifferential() {
+    const size_t maxSize = 8;
+    ArrayStack<Type, 8, Spill> stack;
+    std::vector<Type> reference;
+    std::mt19937 rng(2);
+    for (int i = 0; i < 20000; i++) {
+        switch (rng() % 4) {
+        case 0: {
+            Type value;
+            make(i, value);
+            stack.push(value);
+            if (Spill || reference.size() < maxSize) {
+                reference.push_back(value);
+            }
+            break;
+        }
+        case 1:
+            if (!reference.empty()) {
+                assert(stack.pop() == reference.back());
+                reference.pop_back();
+            }
+            break;
+        case 2: {
+            Type batch[5];
+            for (int j = 0; j < 5; j++) {
+                make(i * 10 + j, batch[j]);
+            }
+            size_t pushed = stack.push_n(batch, 5);
+            assert(pushed == (Spill ? 5 : std::min<size_t>(5, maxSize - reference.size())));
+            reference.insert(reference.end(), batch, batch + pushed);
+            break;
+        }
+        default: {
+            Type out[7];
+            size_t wanted = rng() % 7;
+            size_t popped = stack.pop_n(out, wanted);
+            assert(popped == std::min(wanted, reference.size()));
+            assert(std::equal(out, out + popped, reference.end() - popped));
+            reference.resize(reference.size() - popped);
+        }
+        }
+        assert(stack.count() == reference.size());
+        assert(reference.empty() || stack.peek() == reference.back());
+        if (i % 5000 == 0) {
+            ArrayStack<Type, 8, Spill> copy(stack);
+            stack.clear();
+            stack = copy;
+        }
+    }
+}
+
+int main() {
+    testDifferential<int, false>();
+    testDifferential<int, true>();
+    testDifferential<std::string, false>();
+    testDifferential<std::string, true>();
+    static_assert(sizeof(ArrayStack<int, 8>) == sizeof(size_t) + 8 * sizeof(int),
+        "a non-spilling ArrayStack must not carry the spill state");
+    return 0;
+}
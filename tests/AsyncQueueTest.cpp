@@ -0,0 +1,161 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "AsyncQueue.h"
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Fire-and-forget coroutine, runs until its first suspension when called
+struct Task
+{
+    struct promise_type
+    {
+        Task get_return_object() { return Task(); }
+        std::suspend_never initial_suspend() { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+// Single-threaded event loop so resumption order is deterministic
+struct Loop
+{
+    std::deque<std::coroutine_handle<>> ready;
+
+    void run() {
+        while (!ready.empty()) {
+            std::coroutine_handle<> handle = ready.front();
+            ready.pop_front();
+            handle.resume();
+        }
+    }
+};
+
+struct LoopExecutor
+{
+    Loop* loop;
+
+    void schedule(std::coroutine_handle<> handle) { loop->ready.push_back(handle); }
+};
+
+template<typename Queue, typename Type>
+static Task collect(Queue& queue, std::vector<Type>& out, int& finished) {
+    while (auto value = co_await queue.pop()) {
+        out.push_back(*value);
+    }
+    finished++;
+}
+
+// With no consumer parked the queue is a plain FIFO
+static void testSequential() {
+    AsyncQueue<std::string> queue;
+    std::deque<std::string> reference;
+    std::mt19937 rng(1);
+    for (int i = 0; i < 100000; i++) {
+        if (rng() % 3 != 0) {
+            assert(queue.push(std::to_string(i)));
+            reference.push_back(std::to_string(i));
+        } else {
+            std::string value;
+            assert(queue.try_pop(value) == !reference.empty());
+            if (!reference.empty()) {
+                assert(value == reference.front());
+                reference.pop_front();
+            }
+        }
+        assert(queue.size() == reference.size());
+    }
+}
+
+// Parked consumers are served oldest first, and close() wakes them all empty-handed
+static void testWaiters() {
+    Loop loop;
+    AsyncQueue<int, LoopExecutor> queue(LoopExecutor{ &loop });
+    const int consumers = 100;
+    std::vector<std::vector<int>> received(consumers);
+    int finished = 0;
+    for (int c = 0; c < consumers; c++) {
+        collect(queue, received[c], finished);
+    }
+    // Push one value per parked consumer, then let them run and park again
+    for (int round = 0; round < 50; round++) {
+        for (int c = 0; c < consumers; c++) {
+            assert(queue.push(round * consumers + c));
+        }
+        assert(queue.empty());
+        loop.run();
+    }
+    // They park again in the order they were resumed, so the order is kept
+    for (int c = 0; c < consumers; c++) {
+        assert(received[c].size() == 50);
+        for (int round = 0; round < 50; round++) {
+            assert(received[c][round] == round * consumers + c);
+        }
+    }
+    queue.close();
+    loop.run();
+    assert(finished == consumers && !queue.push(0));
+}
+
+// Producers on other threads resume the consumer inline, one at a time
+static void testThreads() {
+    const int perProducer = 50000;
+    AsyncQueue<int> queue;
+    std::vector<int> received;
+    int finished = 0;
+    collect(queue, received, finished);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 2; p++) {
+        producers.emplace_back([&queue, p, perProducer] {
+            for (int i = 0; i < perProducer; i++) {
+                queue.push(p * perProducer + i);
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    queue.close();
+    assert(finished == 1);
+    std::sort(received.begin(), received.end());
+    assert(received.size() == 2 * perProducer);
+    for (int i = 0; i < 2 * perProducer; i++) {
+        assert(received[i] == i);
+    }
+}
+
+int main() {
+    testSequential();
+    testWaiters();
+    testThreads();
+    return 0;
+}
@@ -0,0 +1,162 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Cache.h"
+#include "HashIndex.h"
+#include <cassert>
+#include <map>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+static void testHashIndex() {
+    HashIndex<int, int> index;
+    std::map<int, int> reference;
+    std::mt19937 rng(1);
+    for (int i = 0; i < 300000; i++) {
+        int key = rng() % 3000;
+        switch (rng() % 3) {
+        case 0:
+            assert(index.insert(key, i) == reference.insert_or_assign(key, i).second);
+            break;
+        case 1:
+            assert(index.erase(key) == (reference.erase(key) == 1));
+            break;
+        default: {
+            int* value = index.find(key);
+            auto it = reference.find(key);
+            assert((value != nullptr) == (it != reference.end()));
+            assert(value == nullptr || *value == it->second);
+        }
+        }
+    }
+    assert(index.size() == reference.size());
+}
+
+// Reference entries remember their value, use count and last use
+struct Use
+{
+    int value;
+    long count;
+    long time;
+};
+
+// Evict the entry that minimises rank, as the cache under test should
+template<typename Rank>
+static void evict(std::map<int, Use>& reference, Rank rank) {
+    auto victim = reference.begin();
+    for (auto it = reference.begin(); it != reference.end(); ++it) {
+        if (rank(it->second) < rank(victim->second)) {
+            victim = it;
+        }
+    }
+    reference.erase(victim);
+}
+
+template<typename Cache, typename Rank>
+static void testPolicy(Rank rank) {
+    const size_t capacity = 50;
+    Cache cache(capacity);
+    std::map<int, Use> reference;
+    std::mt19937 rng(2);
+    for (long time = 0; time < 200000; time++) {
+        int key = rng() % 120;
+        auto it = reference.find(key);
+        switch (rng() % 4) {
+        case 0:
+        case 1: {
+            int* value = cache.get(key);
+            assert((value != nullptr) == (it != reference.end()));
+            if (value != nullptr) {
+                assert(*value == it->second.value);
+                it->second.count++;
+                it->second.time = time;
+            }
+            break;
+        }
+        case 2:
+            if (it != reference.end()) {
+                it->second = Use{ static_cast<int>(time), it->second.count + 1, time };
+            } else {
+                if (reference.size() == capacity) {
+                    evict(reference, rank);
+                }
+                reference[key] = Use{ static_cast<int>(time), 1, time };
+            }
+            cache.put(key, static_cast<int>(time));
+            break;
+        default:
+            assert(cache.erase(key) == (it != reference.end()));
+            if (it != reference.end()) {
+                reference.erase(it);
+            }
+        }
+        assert(cache.size() == reference.size());
+    }
+}
+
+static void testSharded() {
+    for (size_t capacity : { 0, 1, 15, 16, 17, 100, 1000, 1023 }) {
+        ShardedLRUCache<int, int> lru(capacity);
+        ShardedLFUCache<int, int, 8> lfu(capacity);
+        assert(lru.capacity() == capacity && lfu.capacity() == capacity);
+        for (int i = 0; i < 5000; i++) {
+            lru.put(i, i);
+            lfu.put(i, i);
+        }
+        assert(lru.size() <= capacity && lfu.size() <= capacity);
+    }
+
+    ShardedLRUCache<int, int> cache(1000);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&cache] {
+            for (int i = 0; i < 50000; i++) {
+                int value;
+                if (cache.get(i % 2000, value)) {
+                    assert(value == i % 2000);
+                } else {
+                    cache.put(i % 2000, i % 2000);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    assert(cache.size() <= cache.capacity());
+    CacheStats stats = cache.stats();
+    assert(stats.hits + stats.misses == 4 * 50000);
+}
+
+int main() {
+    testHashIndex();
+    testPolicy<LRUCache<int, int>>([](const Use& use) { return use.time; });
+    testPolicy<LFUCache<int, int>>([](const Use& use) { return std::make_pair(use.count, use.time); });
+    testSharded();
+    return 0;
+}
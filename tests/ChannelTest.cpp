@@ -0,0 +1,146 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Channel.h"
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// The non-blocking calls on one thread have to match a bounded FIFO
+static void testSequential() {
+    Channel<std::string> channel(8);
+    std::deque<std::string> reference;
+    std::mt19937 rng(1);
+    for (int i = 0; i < 100000; i++) {
+        switch (rng() % 3) {
+        case 0:
+            assert(channel.try_push(std::to_string(i)) == (reference.size() < channel.capacity()));
+            if (reference.size() < channel.capacity()) {
+                reference.push_back(std::to_string(i));
+            }
+            break;
+        case 1: {
+            std::string value;
+            assert(channel.try_pop(value) == !reference.empty());
+            if (!reference.empty()) {
+                assert(value == reference.front());
+                reference.pop_front();
+            }
+            break;
+        }
+        default:
+            // pop_bulk only blocks when the channel is empty
+            if (!reference.empty()) {
+                std::string out[4];
+                size_t popped = channel.pop_bulk(out, 4);
+                assert(popped == std::min<size_t>(4, reference.size()));
+                for (size_t j = 0; j < popped; j++) {
+                    assert(out[j] == reference.front());
+                    reference.pop_front();
+                }
+            }
+        }
+        assert(channel.size() == reference.size());
+    }
+
+    channel.close();
+    assert(channel.closed() && !channel.push("late") && !channel.try_push("late"));
+    std::string value;
+    while (!reference.empty()) {
+        assert(channel.pop(value) && value == reference.front());
+        reference.pop_front();
+    }
+    assert(!channel.pop(value));
+}
+
+// Producers block on a full channel and consumers on an empty one until close();
+// every value comes out once, in each producer's order
+static void testConcurrent(int producers, int consumers) {
+    const long perProducer = 100000;
+    Channel<long> channel(64);
+    std::vector<std::vector<long>> popped(consumers);
+    std::vector<std::thread> producerThreads;
+    std::vector<std::thread> consumerThreads;
+    for (int p = 0; p < producers; p++) {
+        producerThreads.emplace_back([&channel, p, perProducer] {
+            for (long i = 0; i < perProducer; i++) {
+                bool pushed = channel.push(p * perProducer + i);
+                assert(pushed);
+                (void)pushed;
+            }
+        });
+    }
+    for (int c = 0; c < consumers; c++) {
+        consumerThreads.emplace_back([&channel, &popped, c] {
+            if (c % 2 == 0) {
+                long value;
+                while (channel.pop(value)) {
+                    popped[c].push_back(value);
+                }
+            } else {
+                long out[16];
+                size_t count;
+                while ((count = channel.pop_bulk(out, 16)) > 0) {
+                    popped[c].insert(popped[c].end(), out, out + count);
+                }
+            }
+        });
+    }
+    for (auto& thread : producerThreads) {
+        thread.join();
+    }
+    channel.close();
+    for (auto& thread : consumerThreads) {
+        thread.join();
+    }
+    std::vector<long> all;
+    for (auto& values : popped) {
+        std::vector<long> last(producers, -1);
+        for (long value : values) {
+            assert(value > last[value / perProducer]);
+            last[value / perProducer] = value;
+        }
+        all.insert(all.end(), values.begin(), values.end());
+    }
+    std::sort(all.begin(), all.end());
+    assert(all.size() == static_cast<size_t>(producers * perProducer));
+    for (size_t i = 0; i < all.size(); i++) {
+        assert(all[i] == static_cast<long>(i));
+    }
+}
+
+int main() {
+    testSequential();
+    testConcurrent(1, 1);
+    testConcurrent(3, 3);
+    testConcurrent(4, 1);
+    testConcurrent(1, 4);
+    return 0;
+}
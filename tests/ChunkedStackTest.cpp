@@ -0,0 +1,131 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ChunkedStack.h"
+#include <cassert>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+static void testDifferential() {
+    ChunkedStack<std::string, 4> stack;
+    std::vector<std::string> reference;
+    std::mt19937 rng(1);
+    for (int i = 0; i < 100000; i++) {
+        if (rng() % 3 != 0) {
+            stack.push(std::to_string(i));
+            reference.push_back(std::to_string(i));
+        } else if (!reference.empty()) {
+            assert(stack.peek() == reference.back());
+            assert(stack.pop() == reference.back());
+            reference.pop_back();
+        }
+        if (i % 10000 == 0) {
+            ChunkedStack<std::string, 4> copy(stack);
+            ChunkedStack<std::string, 4> moved(std::move(stack));
+            assert(stack.empty());
+            stack = copy;
+            copy = std::move(moved);
+        }
+        assert(stack.size() == reference.size());
+    }
+    while (!reference.empty()) {
+        assert(stack.pop() == reference.back());
+        reference.pop_back();
+    }
+    assert(stack.empty());
+}
+
+static void testSpares() {
+    ChunkedStack<int, 4> stack;
+    stack.reserve(100);
+    assert(stack.capacity() >= 100);
+    size_t reserved = stack.capacity();
+    for (int i = 0; i < 400; i++) {
+        stack.push(i);
+    }
+    // clear() keeps every chunk for the refill...
+    size_t full = stack.capacity();
+    stack.clear();
+    assert(stack.capacity() == full);
+    // ...but only what reserve() asked for survives the next shrink
+    for (int i = 0; i < 400; i++) {
+        stack.push(i);
+    }
+    for (int i = 0; i < 400; i++) {
+        stack.pop();
+    }
+    assert(stack.capacity() == reserved);
+    stack.shrink_to_fit();
+    assert(stack.capacity() == 0);
+}
+
+// Copying throws once the countdown reaches zero
+static int copiesLeft = -1;
+
+struct Fragile
+{
+    int value;
+
+    Fragile(int value_ = 0) : value(value_) {}
+    Fragile(const Fragile& other) : value(other.value) {
+        if (copiesLeft >= 0 && copiesLeft-- == 0) {
+            throw std::runtime_error("copy failed");
+        }
+    }
+    Fragile& operator=(const Fragile& other) = default;
+};
+
+static void testThrowingPush() {
+    ChunkedStack<Fragile, 4> stack;
+    for (int i = 0; i < 4; i++) {
+        stack.push(Fragile(i));
+    }
+    // The top chunk is full, so this push starts a new chunk before the copy throws
+    Fragile value(9);
+    copiesLeft = 1;
+    bool threw = false;
+    try {
+        stack.push(value);
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    copiesLeft = -1;
+    assert(threw);
+    assert(stack.size() == 4 && stack.peek().value == 3);
+    for (int i = 3; i >= 0; i--) {
+        assert(stack.pop().value == i);
+    }
+}
+
+int main() {
+    testDifferential();
+    testSpares();
+    testThrowingPush();
+    return 0;
+}
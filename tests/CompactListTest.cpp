@@ -0,0 +1,128 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "CompactList.h"
+#include <cassert>
+#include <iterator>
+#include <list>
+#include <random>
+#include <utility>
+#include <vector>
+
+typedef CompactList<int>::Index Index;
+
+static void check(const CompactList<int>& list, const std::list<int>& reference) {
+    assert(list.size() == reference.size());
+    auto it = reference.begin();
+    for (Index node = list.head(); node != list.npos; node = list.next(node)) {
+        assert(list.value(node) == *it++);
+    }
+    assert(it == reference.end());
+    for (Index node = list.tail(); node != list.npos; node = list.prev(node)) {
+        assert(list.value(node) == *--it);
+    }
+}
+
+int main() {
+    CompactList<int> list;
+    std::list<int> reference;
+    // Slot indices and iterators to the same nodes, kept side by side
+    std::vector<Index> nodes;
+    std::vector<std::list<int>::iterator> its;
+    std::mt19937 rng(5);
+    for (int i = 0; i < 100000; i++) {
+        switch (rng() % 6) {
+        case 0:
+            nodes.push_back(list.insert(i));
+            its.push_back(reference.insert(reference.end(), i));
+            break;
+        case 1:
+            nodes.push_back(list.unshift(i));
+            its.push_back(reference.insert(reference.begin(), i));
+            break;
+        case 2:
+            if (!nodes.empty()) {
+                size_t j = rng() % nodes.size();
+                nodes.push_back(list.insertBefore(nodes[j], i));
+                its.push_back(reference.insert(its[j], i));
+            }
+            break;
+        case 3:
+            if (!nodes.empty()) {
+                size_t j = rng() % nodes.size();
+                nodes.push_back(list.insertAfter(nodes[j], i));
+                its.push_back(reference.insert(std::next(its[j]), i));
+            }
+            break;
+        case 4:
+            if (!nodes.empty()) {
+                size_t j = rng() % nodes.size();
+                list.remove(nodes[j]);
+                reference.erase(its[j]);
+                nodes[j] = nodes.back();
+                its[j] = its.back();
+                nodes.pop_back();
+                its.pop_back();
+            }
+            break;
+        default:
+            if (rng() % 500 == 0) {
+                // compact() renumbers every slot, so collect them again in list order
+                list.compact();
+                nodes.clear();
+                its.clear();
+                for (Index node = list.head(); node != list.npos; node = list.next(node)) {
+                    nodes.push_back(node);
+                }
+                for (auto it = reference.begin(); it != reference.end(); ++it) {
+                    its.push_back(it);
+                }
+                assert(list.head() == 0 || list.empty());
+            }
+        }
+        assert(list.size() == reference.size());
+    }
+    check(list, reference);
+
+    CompactList<int> copy(list);
+    list.compact();
+    check(copy, reference);
+    CompactList<int> moved(std::move(copy));
+    check(moved, reference);
+    copy = list;
+    check(copy, reference);
+
+    CompactList<int> sorted;
+    std::list<int> sortedReference;
+    for (int i = 0; i < 1000; i++) {
+        int value = rng() % 100;
+        sorted.priorityInsert(value);
+        sortedReference.push_back(value);
+    }
+    sortedReference.sort();
+    check(sorted, sortedReference);
+    return 0;
+}
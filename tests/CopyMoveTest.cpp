@@ -0,0 +1,134 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "LinkedList.h"
+#include "Queue.h"
+#include "Stack.h"
+#include <cassert>
+#include <deque>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Copies have to be deep: mutating the source afterwards must not show up in the copy
+static void testLinkedList() {
+    LinkedList<std::string> list;
+    std::deque<std::string> reference;
+    std::mt19937 rng(1);
+    for (int i = 0; i < 20000; i++) {
+        switch (rng() % 4) {
+        case 0:
+            list.insert(std::to_string(i));
+            reference.push_back(std::to_string(i));
+            break;
+        case 1:
+            list.unshift(std::to_string(i));
+            reference.push_front(std::to_string(i));
+            break;
+        case 2:
+            if (!reference.empty()) {
+                list.remove();
+                reference.pop_front();
+            }
+            break;
+        default: {
+            LinkedList<std::string> copy(list);
+            list.insert("tail");
+            assert(copy.size() == reference.size());
+            list.remove(list[list.size() - 1]);
+            LinkedList<std::string> moved(std::move(copy));
+            assert(copy.empty());
+            list = moved;
+            moved.clear();
+            LinkedList<std::string> assigned;
+            assigned = std::move(list);
+            list = std::move(assigned);
+        }
+        }
+        assert(list.size() == reference.size());
+        if (i % 1000 == 0) {
+            for (size_t j = 0; j < reference.size(); j++) {
+                assert(list[j] == reference[j]);
+            }
+        }
+    }
+}
+
+static void testStack() {
+    Stack<int> stack;
+    std::vector<int> reference;
+    std::mt19937 rng(2);
+    for (int i = 0; i < 50000; i++) {
+        if (rng() % 3 != 0) {
+            stack.push(i);
+            reference.push_back(i);
+        } else if (!reference.empty()) {
+            assert(stack.pop() == reference.back());
+            reference.pop_back();
+        }
+        if (i % 5000 == 0) {
+            Stack<int> copy(stack);
+            stack.push(-1);
+            Stack<int> moved(std::move(copy));
+            assert(copy.empty());
+            stack = moved;
+        }
+        assert(stack.empty() == reference.empty());
+        assert(reference.empty() || stack.peek() == reference.back());
+    }
+}
+
+static void testQueue() {
+    Queue<int> queue;
+    std::deque<int> reference;
+    std::mt19937 rng(3);
+    for (int i = 0; i < 50000; i++) {
+        if (rng() % 3 != 0) {
+            queue.push(i);
+            reference.push_back(i);
+        } else if (!reference.empty()) {
+            assert(queue.pop() == reference.front());
+            reference.pop_front();
+        }
+        if (i % 5000 == 0) {
+            Queue<int> copy(queue);
+            queue.push(-1);
+            Queue<int> moved(std::move(copy));
+            assert(copy.empty());
+            queue = moved;
+        }
+        assert(queue.size() == reference.size());
+        assert(reference.empty() || (queue.front() == reference.front() && queue.back() == reference.back()));
+    }
+}
+
+int main() {
+    testLinkedList();
+    testStack();
+    testQueue();
+    return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "DaryHeap.h"
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+
+static void make(std::mt19937& rng, int32_t& value) { value = static_cast<int32_t>(rng() % 200) - 100; }
+// Large unsigned keys catch a signed SIMD compare
+static void make(std::mt19937& rng, uint32_t& value) { value = static_cast<uint32_t>(rng() % 200) * 30000000u; }
+static void make(std::mt19937& rng, float& value) { value = static_cast<float>(rng() % 300) / 7.0f; }
+static void make(std::mt19937& rng, double& value) { value = static_cast<double>(rng() % 500); }
+static void make(std::mt19937& rng, std::string& value) { value = std::to_string(rng() % 500); }
+
+// A multiset ordered by the same Compare keeps the heap top as its last element
+template<typename Type, size_t Arity, typename Compare>
+static void testDifferential() {
+    DaryHeap<Type, Arity, Compare> heap;
+    std::multiset<Type, Compare> reference;
+    std::mt19937 rng(7);
+    for (int i = 0; i < 60000; i++) {
+        switch (rng() % 5) {
+        case 0:
+        case 1: {
+            Type value;
+            make(rng, value);
+            heap.push(value);
+            reference.insert(value);
+            break;
+        }
+        case 2:
+        case 3:
+            if (!reference.empty()) {
+                assert(heap.pop() == *reference.rbegin());
+                reference.erase(std::prev(reference.end()));
+            }
+            break;
+        default: {
+            // Mostly small ranges that sift in, sometimes large ones that heapify
+            Type batch[70];
+            size_t count = rng() % (rng() % 10 == 0 ? 70 : 3);
+            for (size_t j = 0; j < count; j++) {
+                make(rng, batch[j]);
+                reference.insert(batch[j]);
+            }
+            heap.push_range(batch, count);
+        }
+        }
+        assert(heap.size() == reference.size());
+        assert(reference.empty() || heap.front() == *reference.rbegin());
+    }
+    DaryHeap<Type, Arity, Compare> moved(std::move(heap));
+    assert(heap.empty());
+    while (!reference.empty()) {
+        assert(moved.pop() == *reference.rbegin());
+        reference.erase(std::prev(reference.end()));
+    }
+    assert(moved.empty());
+}
+
+int main() {
+    // The key types and arities the SIMD path handles, and a few it leaves to the scalar one
+    testDifferential<int32_t, 4, std::less<int32_t>>();
+    testDifferential<int32_t, 8, std::greater<int32_t>>();
+    testDifferential<int32_t, 16, std::less<int32_t>>();
+    testDifferential<uint32_t, 4, std::less<uint32_t>>();
+    testDifferential<uint32_t, 8, std::greater<uint32_t>>();
+    testDifferential<float, 4, std::greater<float>>();
+    testDifferential<float, 8, std::less<float>>();
+    testDifferential<double, 2, std::greater<double>>();
+    testDifferential<std::string, 3, std::less<std::string>>();
+    return 0;
+}
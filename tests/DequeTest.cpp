@@ -0,0 +1,148 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "Deque.h"
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <numeric>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+static void make(int i, int& value) { value = i; }
+static void make(int i, std::string& value) { value = std::to_string(i); }
+
+template<typename Type>
+static void testDifferential() {
+    Deque<Type> deque;
+    std::deque<Type> reference;
+    std::mt19937 rng(3);
+    for (int i = 0; i < 100000; i++) {
+        Type value;
+        make(i, value);
+        switch (rng() % 8) {
+        case 0:
+            deque.push_back(value);
+            reference.push_back(value);
+            break;
+        case 1:
+            deque.push_front(value);
+            reference.push_front(value);
+            break;
+        case 2:
+            if (!reference.empty()) {
+                assert(deque.pop_back() == reference.back());
+                reference.pop_back();
+            }
+            break;
+        case 3:
+            if (!reference.empty()) {
+                assert(deque.pop_front() == reference.front());
+                reference.pop_front();
+            }
+            break;
+        case 4: {
+            Type batch[7];
+            size_t count = rng() % 7;
+            for (size_t j = 0; j < count; j++) {
+                make(i * 10 + j, batch[j]);
+            }
+            if (rng() % 2) {
+                deque.push_back_range(batch, count);
+                reference.insert(reference.end(), batch, batch + count);
+            } else {
+                deque.push_front_range(batch, count);
+                reference.insert(reference.begin(), batch, batch + count);
+            }
+            break;
+        }
+        case 5: {
+            Type out[7];
+            size_t wanted = rng() % 7;
+            if (rng() % 2) {
+                size_t popped = deque.pop_front_range(out, wanted);
+                assert(popped == std::min(wanted, reference.size()));
+                assert(std::equal(out, out + popped, reference.begin()));
+                reference.erase(reference.begin(), reference.begin() + popped);
+            } else {
+                size_t popped = deque.pop_back_range(out, wanted);
+                assert(popped == std::min(wanted, reference.size()));
+                assert(std::equal(out, out + popped, reference.end() - popped));
+                reference.erase(reference.end() - popped, reference.end());
+            }
+            break;
+        }
+        case 6:
+            if (!reference.empty()) {
+                size_t pos = rng() % reference.size();
+                deque[pos] = value;
+                reference[pos] = value;
+            }
+            break;
+        default:
+            if (i % 1000 == 0) {
+                Deque<Type> copy(deque);
+                Deque<Type> moved(std::move(deque));
+                deque = copy;
+                copy = std::move(moved);
+            }
+        }
+        assert(deque.size() == reference.size());
+        assert(reference.empty() || (deque.front() == reference.front() && deque.back() == reference.back()));
+    }
+    const Deque<Type>& view = deque;
+    assert(std::equal(view.begin(), view.end(), reference.begin(), reference.end()));
+    for (size_t pos = 0; pos < reference.size(); pos++) {
+        assert(view.at(pos) == reference[pos] && view[pos] == reference[pos]);
+    }
+}
+
+static void testIterators() {
+    Deque<int> deque;
+    for (int i = 0; i < 100; i++) {
+        deque.push_back(i);
+        deque.push_front(-i);
+    }
+    const Deque<int>& view = deque;
+    static_assert(std::is_same<decltype(view[0]), const int&>::value, "const operator[] must not hand out mutable references");
+    static_assert(std::is_same<decltype(view.at(0)), const int&>::value, "const at() must not hand out mutable references");
+    static_assert(std::is_same<decltype(*view.begin()), const int&>::value, "const begin() must give a ConstIterator");
+    Deque<int>::ConstIterator first = deque.begin();
+    assert(*first == -99);
+    std::sort(deque.begin(), deque.end());
+    assert(std::is_sorted(view.begin(), view.end()));
+    assert(std::accumulate(view.begin(), view.end(), 0) == 0);
+    assert(view.end() - view.begin() == 200);
+}
+
+int main() {
+    testDifferential<int>();
+    testDifferential<std::string>();
+    testIterators();
+    return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "EliminationStack.h"
+#include <algorithm>
+#include <cassert>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Single-threaded every CAS succeeds, so it has to behave exactly like a stack
+static void testSequential() {
+    EliminationStack<std::string> stack;
+    std::vector<std::string> reference;
+    std::mt19937 rng(1);
+    for (int i = 0; i < 100000; i++) {
+        if (rng() % 3 != 0) {
+            stack.push(std::to_string(i));
+            reference.push_back(std::to_string(i));
+        } else {
+            std::string value;
+            assert(stack.try_pop(value) == !reference.empty());
+            if (!reference.empty()) {
+                assert(value == reference.back());
+                reference.pop_back();
+            }
+        }
+        assert(stack.empty() == reference.empty());
+    }
+    assert(stack.eliminated() == 0);
+}
+
+// Every value pushed by some thread has to be popped exactly once, whether it
+// went through the stack or was handed over in the elimination array
+static void testConcurrent(int threads) {
+    const long perThread = 100000;
+    EliminationStack<long> stack;
+    std::vector<std::vector<long>> popped(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&stack, &popped, t, perThread] {
+            for (long i = 0; i < perThread; i++) {
+                stack.push(t * perThread + i);
+                long value;
+                if (stack.try_pop(value)) {
+                    popped[t].push_back(value);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::vector<long> all;
+    for (auto& values : popped) {
+        all.insert(all.end(), values.begin(), values.end());
+    }
+    long value;
+    while (stack.try_pop(value)) {
+        all.push_back(value);
+    }
+    std::sort(all.begin(), all.end());
+    assert(all.size() == static_cast<size_t>(threads * perThread));
+    for (size_t i = 0; i < all.size(); i++) {
+        assert(all[i] == static_cast<long>(i));
+    }
+}
+
+int main() {
+    testSequential();
+    for (int threads : { 1, 2, 4, 8 }) {
+        testConcurrent(threads);
+    }
+    return 0;
+}
@@ -0,0 +1,178 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "CompactList.h"
+#include "LLQueue.h"
+#include "PriorityQueue.h"
+#include <cassert>
+#include <iterator>
+#include <map>
+#include <random>
+#include <vector>
+
+/* Every handle ever handed out is kept with whether its element should still be
+ * there, so stale handles are checked after their slot has been reused. */
+
+static void testCompactList() {
+    typedef CompactList<int>::Handle Handle;
+    CompactList<int> list;
+    std::map<int, Handle> live;
+    std::vector<Handle> dead;
+    std::mt19937 rng(1);
+    for (int i = 0; i < 50000; i++) {
+        switch (rng() % 5) {
+        case 0:
+        case 1:
+            live[i] = list.handle(list.insert(i));
+            break;
+        case 2:
+            if (!live.empty()) {
+                auto it = live.lower_bound(rng() % (i + 1));
+                if (it == live.end()) {
+                    it = live.begin();
+                }
+                assert(list.remove(it->second));
+                assert(!list.remove(it->second));
+                dead.push_back(it->second);
+                live.erase(it);
+            }
+            break;
+        case 3:
+            if (rng() % 100 == 0) {
+                list.compact();
+                // Handles from before compact() all go stale
+                for (auto& entry : live) {
+                    dead.push_back(entry.second);
+                }
+                live.clear();
+                for (CompactList<int>::Index node = list.head(); node != list.npos; node = list.next(node)) {
+                    live[list.value(node)] = list.handle(node);
+                }
+            }
+            break;
+        default:
+            if (rng() % 1000 == 0) {
+                list.clear();
+                for (auto& entry : live) {
+                    dead.push_back(entry.second);
+                }
+                live.clear();
+            }
+        }
+    }
+    for (auto& entry : live) {
+        assert(list.valid(entry.second) && *list.get(entry.second) == entry.first);
+    }
+    for (Handle handle : dead) {
+        assert(!list.valid(handle) && list.get(handle) == nullptr);
+        assert(list.insertAfter(handle, 0).index == list.npos);
+    }
+}
+
+static void testLLQueue() {
+    typedef LLQueue<int>::Handle Handle;
+    LLQueue<int> queue;
+    std::map<int, Handle> live;
+    std::vector<Handle> dead;
+    std::mt19937 rng(2);
+    for (int i = 0; i < 50000; i++) {
+        switch (rng() % 3) {
+        case 0:
+            live[i] = queue.push(i);
+            break;
+        case 1:
+            if (!live.empty()) {
+                assert(queue.pop() == live.begin()->first);
+                dead.push_back(live.begin()->second);
+                live.erase(live.begin());
+            }
+            break;
+        default:
+            if (!live.empty()) {
+                auto it = live.lower_bound(rng() % (i + 1));
+                if (it != live.end()) {
+                    assert(queue.erase(it->second));
+                    dead.push_back(it->second);
+                    live.erase(it);
+                }
+            }
+        }
+        assert(queue.size() == live.size());
+    }
+    for (auto& entry : live) {
+        assert(queue.contains(entry.second));
+    }
+    for (Handle handle : dead) {
+        assert(!queue.contains(handle) && !queue.erase(handle));
+    }
+}
+
+static void testPriorityQueue() {
+    typedef PriorityQueue<int>::Handle Handle;
+    PriorityQueue<int> queue;
+    std::map<int, Handle> live;
+    std::vector<Handle> dead;
+    std::mt19937 rng(3);
+    for (int i = 0; i < 50000; i++) {
+        switch (rng() % 3) {
+        case 0:
+            live[i] = queue.push(i);
+            break;
+        case 1:
+            if (!live.empty()) {
+                // The default Compare puts the largest element on top
+                auto top = std::prev(live.end());
+                assert(queue.pop() == top->first);
+                dead.push_back(top->second);
+                live.erase(top);
+            }
+            break;
+        default:
+            if (!live.empty()) {
+                auto it = live.lower_bound(rng() % (i + 1));
+                if (it != live.end()) {
+                    assert(queue.erase(it->second));
+                    dead.push_back(it->second);
+                    live.erase(it);
+                }
+            }
+        }
+        assert(queue.size() == live.size());
+    }
+    for (auto& entry : live) {
+        assert(queue.contains(entry.second));
+    }
+    for (Handle handle : dead) {
+        assert(!queue.contains(handle) && !queue.erase(handle));
+    }
+}
+
+int main() {
+    testCompactList();
+    testLLQueue();
+    testPriorityQueue();
+    return 0;
+}
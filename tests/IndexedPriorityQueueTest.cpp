@@ -0,0 +1,138 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "IndexedPriorityQueue.h"
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <map>
+#include <random>
+#include <set>
+#include <utility>
+
+typedef IndexedPriorityQueue<int>::Index Index;
+
+// Keys of the queued ids, plus the same pairs ordered by key so the front is first
+struct Reference
+{
+    std::map<Index, int> keys;
+    std::set<std::pair<int, Index>> order;
+
+    bool contains(Index id) const { return keys.count(id) == 1; }
+    void set(Index id, int key) {
+        erase(id);
+        keys[id] = key;
+        order.insert(std::make_pair(key, id));
+    }
+    void erase(Index id) {
+        auto it = keys.find(id);
+        if (it != keys.end()) {
+            order.erase(std::make_pair(it->second, id));
+            keys.erase(it);
+        }
+    }
+};
+
+// The default Compare puts the smallest key on top; ties may pop in any order
+static void testDifferential() {
+    IndexedPriorityQueue<int> queue;
+    Reference reference;
+    std::mt19937 rng(11);
+    for (int i = 0; i < 200000; i++) {
+        Index id = rng() % 3000;
+        int key = rng() % 1000;
+        switch (rng() % 6) {
+        case 0:
+            assert(queue.push(id, key) == !reference.contains(id));
+            if (!reference.contains(id)) {
+                reference.set(id, key);
+            }
+            break;
+        case 1:
+            if (reference.contains(id)) {
+                key = std::min(key, reference.keys[id]);
+                queue.decrease_key(id, key);
+                reference.set(id, key);
+            }
+            break;
+        case 2:
+            if (reference.contains(id)) {
+                key = std::max(key, reference.keys[id]);
+                queue.increase_key(id, key);
+                reference.set(id, key);
+            }
+            break;
+        case 3:
+            queue.update(id, key);
+            reference.set(id, key);
+            break;
+        case 4:
+            assert(queue.erase(id) == reference.contains(id));
+            reference.erase(id);
+            break;
+        default:
+            if (!reference.order.empty()) {
+                int front = queue.frontKey();
+                assert(front == reference.order.begin()->first);
+                Index popped = queue.pop();
+                assert(reference.contains(popped) && reference.keys[popped] == front);
+                reference.erase(popped);
+            }
+        }
+        if (rng() % 50000 == 0) {
+            queue.clear();
+            reference = Reference();
+        }
+        assert(queue.size() == reference.keys.size());
+        assert(queue.contains(id) == reference.contains(id));
+        assert(!reference.contains(id) || queue.key(id) == reference.keys[id]);
+    }
+}
+
+static void testEdges() {
+    // A max-queue: decrease_key and increase_key follow Compare, not the key values
+    IndexedPriorityQueue<double, std::less<double>> max(4);
+    max.push(2, 1.0);
+    max.push(1, 3.0);
+    max.push(0, 2.0);
+    max.decrease_key(2, 5.0);
+    max.increase_key(1, 0.5);
+    assert(max.front() == 2 && max.key(2) == 5.0 && max.key(1) == 0.5);
+    IndexedPriorityQueue<double, std::less<double>> moved(std::move(max));
+    assert(moved.pop() == 2 && moved.pop() == 0 && moved.pop() == 1 && moved.empty());
+
+    // npos is the empty marker of the position table and can never be queued
+    IndexedPriorityQueue<int> queue;
+    assert(!queue.push(queue.npos, 1));
+    queue.update(queue.npos, 2);
+    assert(queue.empty() && queue.push(5, 1) && queue.front() == 5);
+}
+
+int main() {
+    testDifferential();
+    testEdges();
+    return 0;
+}
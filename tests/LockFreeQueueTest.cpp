@@ -0,0 +1,115 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "LockFreeQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <deque>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void testSequential() {
+    LockFreeQueue<std::string> queue;
+    std::deque<std::string> reference;
+    std::mt19937 rng(1);
+    for (int i = 0; i < 200000; i++) {
+        if (rng() % 3 != 0) {
+            queue.push(std::to_string(i));
+            reference.push_back(std::to_string(i));
+        } else {
+            std::string value;
+            assert(queue.try_pop(value) == !reference.empty());
+            if (!reference.empty()) {
+                assert(value == reference.front());
+                reference.pop_front();
+            }
+        }
+        assert(queue.empty() == reference.empty());
+        if (i % 50000 == 0) {
+            queue.clear();
+            reference.clear();
+        }
+    }
+}
+
+// Every value comes out exactly once, and each consumer sees every producer's
+// values in the order they were pushed
+static void testConcurrent(int producers, int consumers) {
+    const long perProducer = 100000;
+    const long total = producers * perProducer;
+    LockFreeQueue<long> queue;
+    std::atomic<long> taken(0);
+    std::vector<std::vector<long>> popped(consumers);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&queue, p, perProducer] {
+            for (long i = 0; i < perProducer; i++) {
+                queue.push(p * perProducer + i);
+            }
+        });
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads.emplace_back([&queue, &taken, &popped, c, total] {
+            long value;
+            while (taken.load(std::memory_order_relaxed) < total) {
+                if (queue.try_pop(value)) {
+                    popped[c].push_back(value);
+                    taken.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::vector<long> all;
+    for (auto& values : popped) {
+        std::vector<long> last(producers, -1);
+        for (long value : values) {
+            assert(value > last[value / perProducer]);
+            last[value / perProducer] = value;
+        }
+        all.insert(all.end(), values.begin(), values.end());
+    }
+    std::sort(all.begin(), all.end());
+    assert(all.size() == static_cast<size_t>(total));
+    for (size_t i = 0; i < all.size(); i++) {
+        assert(all[i] == static_cast<long>(i));
+    }
+    assert(queue.empty());
+}
+
+int main() {
+    testSequential();
+    testConcurrent(1, 1);
+    testConcurrent(2, 2);
+    testConcurrent(4, 2);
+    testConcurrent(2, 4);
+    return 0;
+}
@@ -0,0 +1,109 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "LockFreeStack.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+static void testSequential() {
+    LockFreeStack<std::string> stack;
+    std::vector<std::string> reference;
+    std::mt19937 rng(1);
+    for (int i = 0; i < 100000; i++) {
+        switch (rng() % 4) {
+        case 0:
+        case 1:
+            stack.push(std::to_string(i));
+            reference.push_back(std::to_string(i));
+            break;
+        case 2: {
+            std::string batch[3] = { "a" + std::to_string(i), "b" + std::to_string(i), "c" + std::to_string(i) };
+            stack.push_all(batch, batch + 3);
+            reference.insert(reference.end(), batch, batch + 3);
+            break;
+        }
+        default: {
+            std::string value;
+            assert(stack.try_pop(value) == !reference.empty());
+            if (!reference.empty()) {
+                assert(value == reference.back());
+                reference.pop_back();
+            }
+        }
+        }
+        assert(stack.empty() == reference.empty());
+    }
+    // pop_all visits from the top down
+    std::vector<std::string> drained;
+    assert(stack.pop_all([&drained](std::string&& value) { drained.push_back(value); }) == reference.size());
+    std::reverse(reference.begin(), reference.end());
+    assert(drained == reference && stack.empty());
+}
+
+// Every value pushed by some thread has to be popped exactly once
+static void testConcurrent(int threads) {
+    const long perThread = 100000;
+    LockFreeStack<long> stack;
+    std::vector<std::vector<long>> popped(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&stack, &popped, t, perThread] {
+            for (long i = 0; i < perThread; i++) {
+                stack.push(t * perThread + i);
+                long value;
+                if (stack.try_pop(value)) {
+                    popped[t].push_back(value);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    std::vector<long> all;
+    for (auto& values : popped) {
+        all.insert(all.end(), values.begin(), values.end());
+    }
+    stack.pop_all([&all](long&& value) { all.push_back(value); });
+    std::sort(all.begin(), all.end());
+    assert(all.size() == static_cast<size_t>(threads * perThread));
+    for (size_t i = 0; i < all.size(); i++) {
+        assert(all[i] == static_cast<long>(i));
+    }
+}
+
+int main() {
+    testSequential();
+    for (int threads : { 1, 2, 4, 8 }) {
+        testConcurrent(threads);
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "MPMCQueue.h"
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <random>
+#include <thread>
+#include <vector>
+
+static void testSequential() {
+    MPMCQueue<int> queue(16);
+    std::deque<int> reference;
+    std::mt19937 rng(1);
+    for (int i = 0; i < 200000; i++) {
+        if (rng() % 2) {
+            assert(queue.try_push(i) == (reference.size() < queue.capacity()));
+            if (reference.size() < queue.capacity()) {
+                reference.push_back(i);
+            }
+        } else {
+            int value;
+            assert(queue.try_pop(value) == !reference.empty());
+            if (!reference.empty()) {
+                assert(value == reference.front());
+                reference.pop_front();
+            }
+        }
+        assert(queue.size() == reference.size());
+    }
+}
+
+// Every value comes out exactly once, and each consumer sees every producer's
+// values in the order they were pushed
+static void testConcurrent(int producers, int consumers) {
+    const long perProducer = 100000;
+    const long total = producers * perProducer;
+    MPMCQueue<long> queue(256);
+    std::vector<std::vector<long>> popped(consumers);
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.emplace_back([&queue, p, perProducer] {
+            for (long i = 0; i < perProducer; i++) {
+                queue.push(p * perProducer + i);
+            }
+        });
+    }
+    for (int c = 0; c < consumers; c++) {
+        // Split the pops so the consumers take exactly total between them
+        long share = total / consumers + (c < total % consumers ? 1 : 0);
+        threads.emplace_back([&queue, &popped, c, share] {
+            for (long i = 0; i < share; i++) {
+                popped[c].push_back(queue.pop());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::vector<long> all;
+    for (auto& values : popped) {
+        std::vector<long> last(producers, -1);
+        for (long value : values) {
+            assert(value > last[value / perProducer]);
+            last[value / perProducer] = value;
+        }
+        all.insert(all.end(), values.begin(), values.end());
+    }
+    std::sort(all.begin(), all.end());
+    assert(all.size() == static_cast<size_t>(total));
+    for (size_t i = 0; i < all.size(); i++) {
+        assert(all[i] == static_cast<long>(i));
+    }
+    assert(queue.empty());
+}
+
+int main() {
+    testSequential();
+    testConcurrent(1, 1);
+    testConcurrent(2, 2);
+    testConcurrent(4, 2);
+    testConcurrent(2, 4);
+    return 0;
+}
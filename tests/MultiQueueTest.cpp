@@ -0,0 +1,113 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "MultiQueue.h"
+#include <atomic>
+#include <cassert>
+#include <iterator>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+// With a single heap the relaxed pop is exact
+static void testDifferential() {
+    MultiQueue<int> queue(1, 1);
+    assert(queue.heaps() == 1);
+    std::multiset<int> reference;
+    std::mt19937 rng(7);
+    int value;
+    for (int i = 0; i < 100000; i++) {
+        if (rng() % 3 != 0) {
+            value = rng() % 1000;
+            queue.push(value);
+            reference.insert(value);
+        } else if (queue.try_pop(value)) {
+            assert(value == *reference.rbegin());
+            reference.erase(std::prev(reference.end()));
+        } else {
+            assert(reference.empty());
+        }
+        assert(queue.size() == reference.size());
+    }
+    queue.clear();
+    assert(queue.empty() && !queue.try_pop(value));
+}
+
+// A capturing lambda is not default-constructible, so every heap must get the caller's copy
+static void testComparator() {
+    int bias = 5;
+    auto compare = [bias](int a, int b) { return a + bias > b + bias; };
+    MultiQueue<int, decltype(compare)> queue(1, 1, compare);
+    for (int i = 0; i < 100; i++) {
+        queue.push((i * 37) % 100);
+    }
+    int value;
+    for (int i = 0; i < 100; i++) {
+        assert(queue.try_pop(value) && value == i);
+    }
+    assert(!queue.try_pop(value));
+}
+
+// Concurrent producers and consumers: every value is popped exactly once
+static void testConcurrent() {
+    const int threads = 4, perThread = 20000;
+    MultiQueue<int> queue(threads);
+    std::vector<std::atomic<int>> seen(threads * perThread);
+    std::atomic<int> popped(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < perThread; i++) {
+                queue.push(t * perThread + i);
+            }
+        });
+        workers.emplace_back([&] {
+            int value;
+            while (popped.load() < threads * perThread) {
+                if (queue.try_pop(value)) {
+                    seen[value].fetch_add(1);
+                    popped.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    int value;
+    assert(queue.empty() && !queue.try_pop(value));
+    for (std::atomic<int>& count : seen) {
+        assert(count.load() == 1);
+    }
+}
+
+int main() {
+    testDifferential();
+    testComparator();
+    testConcurrent();
+    return 0;
+}
@@ -0,0 +1,185 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "PairingHeap.h"
+#include <cassert>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+typedef PairingHeap<long> Heap;
+
+// Values are priority * ids + id, so each value is unique and names its element
+static const long ids = 1000000;
+
+// A heap with its reference multiset and the handles of its live elements
+struct Tracked
+{
+    Heap heap;
+    std::multiset<long> reference;
+    std::vector<std::pair<long, Heap::Handle>> live;
+
+    void forget(long value) {
+        for (size_t i = 0; i < live.size(); i++) {
+            if (live[i].first == value) {
+                live[i] = live.back();
+                live.pop_back();
+                return;
+            }
+        }
+        assert(false);
+    }
+};
+
+// The default Compare puts the smallest value on top
+static void testDifferential() {
+    std::vector<Tracked> heaps(4);
+    std::mt19937 rng(13);
+    long nextId = 0;
+    for (int i = 0; i < 100000; i++) {
+        Tracked& tracked = heaps[rng() % heaps.size()];
+        switch (rng() % 8) {
+        case 0:
+        case 1: {
+            long value = static_cast<long>(rng() % 1000) * ids + nextId++;
+            tracked.live.emplace_back(value, tracked.heap.push(value));
+            tracked.reference.insert(value);
+            break;
+        }
+        case 2:
+        case 3:
+            if (!tracked.heap.empty()) {
+                long value = tracked.heap.pop();
+                assert(value == *tracked.reference.begin());
+                tracked.reference.erase(tracked.reference.begin());
+                tracked.forget(value);
+            }
+            break;
+        case 4:
+            if (!tracked.live.empty()) {
+                auto& entry = tracked.live[rng() % tracked.live.size()];
+                assert(tracked.heap.get(entry.second) == entry.first);
+                long value = entry.first - static_cast<long>(rng() % 100) * ids;
+                if (value < 0) {
+                    value = entry.first;
+                }
+                tracked.heap.decrease_key(entry.second, value);
+                tracked.reference.erase(entry.first);
+                tracked.reference.insert(value);
+                entry.first = value;
+            }
+            break;
+        case 5:
+            if (!tracked.live.empty()) {
+                size_t pick = rng() % tracked.live.size();
+                tracked.heap.erase(tracked.live[pick].second);
+                tracked.reference.erase(tracked.live[pick].first);
+                tracked.live[pick] = tracked.live.back();
+                tracked.live.pop_back();
+            }
+            break;
+        case 6: {
+            // Melding moves every element, and every handle stays valid
+            Tracked& other = heaps[rng() % heaps.size()];
+            if (&other != &tracked) {
+                tracked.heap.meld(other.heap);
+                assert(other.heap.empty());
+                tracked.reference.insert(other.reference.begin(), other.reference.end());
+                tracked.live.insert(tracked.live.end(), other.live.begin(), other.live.end());
+                other.reference.clear();
+                other.live.clear();
+            }
+            break;
+        }
+        default:
+            if (rng() % 3000 == 0) {
+                tracked.heap.clear();
+                tracked.reference.clear();
+                tracked.live.clear();
+            }
+        }
+        for (const Tracked& each : heaps) {
+            assert(each.heap.size() == each.reference.size());
+            assert(each.reference.empty() || each.heap.front() == *each.reference.begin());
+        }
+    }
+    for (Tracked& tracked : heaps) {
+        for (auto& entry : tracked.live) {
+            assert(tracked.heap.get(entry.second) == entry.first);
+        }
+        while (!tracked.reference.empty()) {
+            assert(tracked.heap.pop() == *tracked.reference.begin());
+            tracked.reference.erase(tracked.reference.begin());
+        }
+    }
+}
+
+// A decrease_key in the wrong direction still leaves a valid heap
+static void testAnyDirection() {
+    PairingHeap<int> heap;
+    std::vector<PairingHeap<int>::Handle> handles;
+    std::vector<int> values;
+    std::multiset<int> reference;
+    std::mt19937 rng(2);
+    for (int i = 0; i < 2000; i++) {
+        int value = rng() % 10000;
+        handles.push_back(heap.push(value));
+        values.push_back(value);
+        reference.insert(value);
+    }
+    for (int i = 0; i < 20000; i++) {
+        size_t pick = rng() % handles.size();
+        int value = rng() % 10000;
+        heap.decrease_key(handles[pick], value);
+        reference.erase(reference.find(values[pick]));
+        reference.insert(value);
+        values[pick] = value;
+        assert(heap.get(handles[pick]) == value && heap.front() == *reference.begin());
+    }
+    while (!heap.empty()) {
+        assert(heap.pop() == *reference.begin());
+        reference.erase(reference.begin());
+    }
+}
+
+static void testMove() {
+    PairingHeap<std::string, std::less<std::string>> heap;
+    heap.push("a");
+    heap.push("c");
+    heap.push("b");
+    PairingHeap<std::string, std::less<std::string>> moved(std::move(heap));
+    assert(heap.empty() && moved.size() == 3);
+    assert(moved.pop() == "c" && moved.pop() == "b" && moved.pop() == "a");
+}
+
+int main() {
+    testDifferential();
+    testAnyDirection();
+    testMove();
+    return 0;
+}
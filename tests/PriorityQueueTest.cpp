@@ -0,0 +1,162 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "PriorityQueue.h"
+#include <cassert>
+#include <iterator>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+// The default Compare keeps the largest element on top, like std::priority_queue
+static void testDifferential() {
+    typedef PriorityQueue<int>::Handle Handle;
+    PriorityQueue<int> queue;
+    std::multiset<int> reference;
+    std::vector<std::pair<Handle, int>> handles;
+    std::mt19937 rng(5);
+    for (int i = 0; i < 100000; i++) {
+        switch (rng() % 6) {
+        case 0:
+        case 1: {
+            int value = rng() % 1000;
+            handles.emplace_back(queue.push(value), value);
+            reference.insert(value);
+            break;
+        }
+        case 2:
+            if (!reference.empty()) {
+                assert(queue.pop() == *reference.rbegin());
+                reference.erase(std::prev(reference.end()));
+            }
+            break;
+        case 3:
+            if (!handles.empty()) {
+                auto& entry = handles[rng() % handles.size()];
+                bool live = queue.contains(entry.first);
+                assert(queue.erase(entry.first) == live);
+                if (live) {
+                    reference.erase(reference.find(entry.second));
+                }
+                assert(!queue.contains(entry.first));
+            }
+            break;
+        case 4: {
+            // Mostly small ranges that sift in, sometimes large ones that heapify
+            int batch[50];
+            size_t count = rng() % (rng() % 10 == 0 ? 50 : 3);
+            for (size_t j = 0; j < count; j++) {
+                batch[j] = rng() % 1000;
+                reference.insert(batch[j]);
+            }
+            queue.push_range(batch, count);
+            break;
+        }
+        default:
+            if (rng() % 200 == 0) {
+                queue.clear();
+                reference.clear();
+                for (auto& entry : handles) {
+                    assert(!queue.contains(entry.first));
+                }
+                handles.clear();
+            }
+        }
+        assert(queue.size() == reference.size());
+        assert(reference.empty() || (queue.front() == *reference.rbegin() && queue.back() == *reference.begin()));
+    }
+    while (!reference.empty()) {
+        assert(queue.pop() == *reference.rbegin());
+        reference.erase(std::prev(reference.end()));
+    }
+    assert(queue.empty());
+
+    PriorityQueue<std::string> strings{ "b", "z", "a" };
+    assert(strings.pop() == "z" && strings.pop() == "b" && strings.pop() == "a" && strings.empty());
+}
+
+static bool byLength(const std::string& a, const std::string& b) {
+    return a.size() < b.size();
+}
+
+// Compare and Projection: empty comparators cost no space, stateful ones are kept
+static void testCompare() {
+    static_assert(sizeof(PriorityQueue<int>) == sizeof(PriorityQueue<int, std::greater<>>),
+                  "An empty comparator must not grow the queue");
+
+    MinHeap<int> low{ 5, 1, 4 };
+    assert(low.pop() == 1 && low.front() == 4 && low.back() == 5);
+    MaxHeap<int> high{ 5, 1, 4 };
+    assert(high.pop() == 5 && high.front() == 4 && high.back() == 1);
+
+    // Only the key is compared, so the payload needs no ordering
+    MinHeap<std::pair<unsigned, std::string>, PairFirst> pairs;
+    std::multiset<unsigned> keys;
+    std::mt19937 rng(6);
+    for (int i = 0; i < 10000; i++) {
+        if (rng() % 3 != 0) {
+            unsigned key = rng() % 100;
+            if (i % 2) {
+                pairs.push({ key, std::to_string(key) });
+            } else {
+                pairs.emplace(key, std::to_string(key));
+            }
+            keys.insert(key);
+        } else if (!keys.empty()) {
+            std::pair<unsigned, std::string> top = pairs.pop();
+            assert(top.first == *keys.begin() && top.second == std::to_string(top.first));
+            keys.erase(keys.begin());
+        }
+        assert(pairs.size() == keys.size());
+    }
+    auto handle = pairs.push({ 0, "zero" });
+    assert(pairs.front().second == "zero" && pairs.erase(handle));
+
+    PriorityQueue<std::string, bool (*)(const std::string&, const std::string&)> byLen(byLength);
+    byLen.push("aaa");
+    byLen.push("a");
+    byLen.push("aaaaa");
+    assert(byLen.pop() == "aaaaa" && byLen.pop() == "aaa" && byLen.pop() == "a");
+
+    struct Mod
+    {
+        int m;
+        bool operator()(int a, int b) const { return a % m < b % m; }
+    };
+    PriorityQueue<int, Mod> mod(Mod{ 10 });
+    mod.push(19);
+    mod.push(25);
+    mod.push(31);
+    assert(mod.pop() == 19 && mod.pop() == 25 && mod.pop() == 31);
+}
+
+int main() {
+    testDifferential();
+    testCompare();
+    return 0;
+}
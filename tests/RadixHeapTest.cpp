@@ -0,0 +1,130 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "RadixHeap.h"
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+
+// Monotone keys: every push is at or above the last popped minimum
+template<typename Key>
+static void testRadixDifferential() {
+    RadixHeap<Key> heap;
+    std::multiset<Key> reference;
+    std::mt19937_64 rng(3);
+    Key last = 0;
+    for (int i = 0; i < 200000; i++) {
+        int op = rng() % 5;
+        if (op < 3) {
+            // Mostly small steps, sometimes a jump across many buckets
+            Key step = static_cast<Key>(rng() % (op == 0 ? static_cast<Key>(~Key(0)) / 4 : 1000));
+            Key value = static_cast<Key>(last + step);
+            if (value < last) {
+                value = last;
+            }
+            heap.push(value);
+            reference.insert(value);
+        } else if (!reference.empty()) {
+            if (op == 3) {
+                assert(heap.frontKey() == *reference.begin());
+            }
+            last = heap.pop();
+            assert(last == *reference.begin());
+            reference.erase(reference.begin());
+        }
+        assert(heap.size() == reference.size());
+        if (rng() % 40000 == 0) {
+            heap.clear();
+            reference.clear();
+            last = 0;
+        }
+    }
+    while (!reference.empty()) {
+        assert(heap.pop() == *reference.begin());
+        reference.erase(reference.begin());
+    }
+    assert(heap.empty());
+}
+
+static void testRadixProjection() {
+    RadixHeap<std::pair<uint32_t, std::string>, PairFirst> heap;
+    heap.push({5, "five"});
+    heap.push({2, "two"});
+    heap.push({9, "nine"});
+    assert(heap.pop().second == "two");
+    heap.push({3, "three"});
+    assert(heap.frontKey() == 3 && heap.front().second == "three");
+    assert(heap.pop().first == 3 && heap.pop().first == 5 && heap.pop().first == 9);
+    assert(heap.empty());
+}
+
+// Keys need not be monotone, so the cursor also moves back
+static void testBucketDifferential() {
+    BucketQueue<uint32_t> queue(100);
+    assert(queue.range() == 100);
+    std::multiset<uint32_t> reference;
+    std::mt19937 rng(4);
+    for (int i = 0; i < 200000; i++) {
+        if (rng() % 2) {
+            uint32_t value = rng() % 100;
+            queue.push(value);
+            reference.insert(value);
+        } else if (!reference.empty()) {
+            assert(queue.frontKey() == *reference.begin());
+            assert(queue.pop() == *reference.begin());
+            reference.erase(reference.begin());
+        }
+        assert(queue.size() == reference.size());
+        if (rng() % 50000 == 0) {
+            queue.clear();
+            reference.clear();
+        }
+    }
+}
+
+static void testBucketProjection() {
+    BucketQueue<std::pair<uint8_t, int>, PairFirst> queue(256);
+    queue.push({7, 1});
+    queue.push({3, 2});
+    queue.push({255, 3});
+    assert(queue.front().second == 2);
+    assert(queue.pop().second == 2 && queue.pop().second == 1 && queue.pop().second == 3);
+    assert(queue.empty());
+}
+
+int main() {
+    testRadixDifferential<uint64_t>();
+    testRadixDifferential<uint32_t>();
+    testRadixDifferential<uint16_t>();
+    testRadixDifferential<uint8_t>();
+    testRadixProjection();
+    testBucketDifferential();
+    testBucketProjection();
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "ArrayQueue.h"
+#include "RingQueue.h"
+#include <cassert>
+#include <deque>
+#include <memory>
+#include <random>
+#include <string>
+
+static void make(int i, int& value) { value = i; }
+static void make(int i, std::string& value) { value = std::string(i % 40, static_cast<char>('a' + i % 26)); }
+
+// Drive a queue holding at most maxSize values against std::deque
+template<typename Queue, typename Type>
+static void testDifferential(Queue& queue, size_t maxSize) {
+    std::deque<Type> reference;
+    std::mt19937 rng(4);
+    for (int i = 0; i < 50000; i++) {
+        switch (rng() % 4) {
+        case 0:
+            if (reference.size() < maxSize) {
+                Type value;
+                make(i, value);
+                queue.push(value);
+                reference.push_back(value);
+            }
+            break;
+        case 1:
+            if (!reference.empty()) {
+                assert(queue.front() == reference.front());
+                assert(queue.pop() == reference.front());
+                reference.pop_front();
+            }
+            break;
+        case 2: {
+            Type batch[9];
+            size_t count = rng() % 9;
+            if (reference.size() + count > maxSize) {
+                count = maxSize - reference.size();
+            }
+            for (size_t j = 0; j < count; j++) {
+                make(i * 10 + j, batch[j]);
+            }
+            queue.push_range(batch, count);
+            reference.insert(reference.end(), batch, batch + count);
+            break;
+        }
+        default: {
+            Type out[9];
+            size_t popped = queue.pop_range(out, rng() % 9);
+            for (size_t j = 0; j < popped; j++) {
+                assert(out[j] == reference.front());
+                reference.pop_front();
+            }
+        }
+        }
+        assert(queue.size() == reference.size());
+        assert(reference.empty() || queue.back() == reference.back());
+        if (i % 7000 == 0) {
+            Queue copy(queue);
+            queue = copy;
+        }
+    }
+}
+
+// Values that leave the queue must not stay alive in its buffer
+static void testRelease() {
+    std::shared_ptr<int> shared = std::make_shared<int>(1);
+    RingQueue<std::shared_ptr<int>> queue;
+    for (int i = 0; i < 20; i++) {
+        queue.push(shared);
+    }
+    assert(shared.use_count() == 21);
+    queue.pop();
+    assert(shared.use_count() == 20);
+    {
+        std::shared_ptr<int> out[5];
+        assert(queue.pop_range(out, 5) == 5);
+    }
+    assert(shared.use_count() == 15);
+    queue.clear();
+    assert(shared.use_count() == 1);
+}
+
+int main() {
+    ArrayQueue<int, 20> small;
+    testDifferential<ArrayQueue<int, 20>, int>(small, 20);
+    ArrayQueue<std::string, 32> strings;
+    testDifferential<ArrayQueue<std::string, 32>, std::string>(strings, 32);
+    RingQueue<int> ring;
+    testDifferential<RingQueue<int>, int>(ring, 100000);
+    RingQueue<std::string> ringStrings;
+    testDifferential<RingQueue<std::string>, std::string>(ringStrings, 100000);
+    testRelease();
+    return 0;
+}
@@ -0,0 +1,172 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "SPSCQueue.h"
+#include <cassert>
+#include <deque>
+#include <random>
+#include <thread>
+
+// One thread playing both sides has to see exactly a bounded FIFO
+static void testSequential() {
+    SPSCQueue<long> queue(64);
+    std::deque<long> reference;
+    std::mt19937 rng(1);
+    long next = 0;
+    for (int i = 0; i < 200000; i++) {
+        size_t free = queue.capacity() - reference.size();
+        switch (rng() % 6) {
+        case 0:
+            assert(queue.try_push(next) == (free > 0));
+            if (free > 0) {
+                reference.push_back(next++);
+            }
+            break;
+        case 1: {
+            long batch[16];
+            size_t count = rng() % 16;
+            for (size_t j = 0; j < count; j++) {
+                batch[j] = next + j;
+            }
+            size_t pushed = queue.push_bulk(batch, count);
+            assert(pushed == (count < free ? count : free));
+            for (size_t j = 0; j < pushed; j++) {
+                reference.push_back(next++);
+            }
+            break;
+        }
+        case 2: {
+            size_t count = rng() % 16 + 1;
+            long* slots = queue.try_reserve(count);
+            assert((slots == nullptr) == (free == 0));
+            if (slots != nullptr) {
+                size_t used = rng() % (count + 1);
+                for (size_t j = 0; j < used; j++) {
+                    slots[j] = next;
+                    reference.push_back(next++);
+                }
+                queue.commit(used);
+            }
+            break;
+        }
+        case 3: {
+            long value;
+            assert(queue.try_pop(value) == !reference.empty());
+            if (!reference.empty()) {
+                assert(value == reference.front());
+                reference.pop_front();
+            }
+            break;
+        }
+        case 4: {
+            long out[16];
+            size_t popped = queue.pop_bulk(out, rng() % 16);
+            for (size_t j = 0; j < popped; j++) {
+                assert(out[j] == reference.front());
+                reference.pop_front();
+            }
+            break;
+        }
+        default: {
+            size_t count = rng() % 16 + 1;
+            long* values = queue.try_peek(count);
+            assert((values == nullptr) == reference.empty());
+            if (values != nullptr) {
+                for (size_t j = 0; j < count; j++) {
+                    assert(values[j] == reference[j]);
+                }
+                size_t used = rng() % (count + 1);
+                queue.consume(used);
+                reference.erase(reference.begin(), reference.begin() + used);
+            }
+        }
+        }
+        assert(queue.size() == reference.size());
+    }
+}
+
+// A producer and a consumer thread mixing every API; values arrive in order
+static void testConcurrent() {
+    const long count = 500000;
+    SPSCQueue<long> queue(1024);
+    std::thread producer([&queue, count] {
+        long next = 0;
+        for (int step = 0; next < count; step++) {
+            if (step % 3 == 0) {
+                size_t slots = 64;
+                long* reserved = queue.try_reserve(slots);
+                if (reserved != nullptr) {
+                    size_t used = 0;
+                    for (; used < slots && next < count; used++) {
+                        reserved[used] = next++;
+                    }
+                    queue.commit(used);
+                }
+            } else if (step % 3 == 1) {
+                long batch[16];
+                size_t size = 0;
+                for (; size < 16 && next + static_cast<long>(size) < count; size++) {
+                    batch[size] = next + size;
+                }
+                next += queue.push_bulk(batch, size);
+            } else if (queue.try_push(next)) {
+                next++;
+            }
+        }
+    });
+    long expected = 0;
+    for (int step = 0; expected < count; step++) {
+        if (step % 3 == 0) {
+            long out[32];
+            size_t popped = queue.pop_bulk(out, 32);
+            for (size_t j = 0; j < popped; j++) {
+                assert(out[j] == expected++);
+            }
+        } else if (step % 3 == 1) {
+            size_t size = 40;
+            long* values = queue.try_peek(size);
+            if (values != nullptr) {
+                for (size_t j = 0; j < size; j++) {
+                    assert(values[j] == expected++);
+                }
+                queue.consume(size);
+            }
+        } else {
+            long value;
+            if (queue.try_pop(value)) {
+                assert(value == expected++);
+            }
+        }
+    }
+    producer.join();
+    assert(queue.empty());
+}
+
+int main() {
+    testSequential();
+    testConcurrent();
+    return 0;
+}
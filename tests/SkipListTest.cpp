@@ -0,0 +1,129 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "SkipList.h"
+#include <cassert>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+static void testMap() {
+    SkipListMap<int, std::string> map;
+    std::map<int, std::string> reference;
+    std::mt19937 rng(1);
+    for (int i = 0; i < 200000; i++) {
+        int key = rng() % 5000;
+        switch (rng() % 4) {
+        case 0:
+            assert(map.insert(key, std::to_string(i)) == reference.insert_or_assign(key, std::to_string(i)).second);
+            break;
+        case 1:
+            assert(map.erase(key) == (reference.erase(key) == 1));
+            break;
+        case 2:
+            map[key] += "x";
+            reference[key] += "x";
+            break;
+        default: {
+            const SkipListMap<int, std::string>& view = map;
+            const std::string* value = view.find(key);
+            auto it = reference.find(key);
+            assert((value != nullptr) == (it != reference.end()));
+            assert(value == nullptr || *value == it->second);
+        }
+        }
+        assert(map.size() == reference.size());
+    }
+
+    auto it = reference.begin();
+    for (auto& node : map) {
+        assert(node.key == it->first && node.value == it->second);
+        ++it;
+    }
+    assert(it == reference.end());
+
+    size_t visited = 0;
+    map.range(100, 200, [&visited](const int& key, std::string&) {
+        assert(key >= 100 && key < 200);
+        visited++;
+    });
+    auto from = reference.lower_bound(100);
+    assert(visited == static_cast<size_t>(std::distance(from, reference.lower_bound(200))));
+    assert(from == reference.end() ? map.lowerBound(100) == map.end() : map.lowerBound(100)->key == from->first);
+
+    static_assert(std::is_same<decltype(std::declval<const SkipListMap<int, int>&>().find(0)), const int*>::value,
+        "find on a const map has to return a const pointer");
+}
+
+static void testSet() {
+    SkipListSet<int> set;
+    std::set<int> reference;
+    std::mt19937 rng(2);
+    for (int i = 0; i < 100000; i++) {
+        int key = rng() % 2000;
+        if (rng() % 2) {
+            assert(set.insert(key) == reference.insert(key).second);
+        } else {
+            assert(set.erase(key) == (reference.erase(key) == 1));
+        }
+        assert(set.contains(key) == (reference.count(key) == 1));
+    }
+    auto it = reference.begin();
+    for (auto& node : set) {
+        assert(node.key == *it++);
+    }
+    assert(it == reference.end());
+}
+
+static void testConcurrent() {
+    ConcurrentSkipListMap<int, int> map;
+    std::thread writer([&map] {
+        for (int i = 0; i < 10000; i++) {
+            map.insert(i, i);
+        }
+    });
+    std::thread reader([&map] {
+        int value;
+        for (int i = 0; i < 10000; i++) {
+            if (map.find(i, value)) {
+                assert(value == i);
+            }
+        }
+    });
+    writer.join();
+    reader.join();
+    assert(map.size() == 10000);
+}
+
+int main() {
+    testMap();
+    testSet();
+    testConcurrent();
+    return 0;
+}
@@ -0,0 +1,148 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "SlidingWindow.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// Non-commutative, so the aggregate also checks the fold order
+struct Concat
+{
+    std::string operator()(const std::string& a, const std::string& b) const { return a + b; }
+};
+
+// A window of the last span values, mixing single pushes and push_range
+static void testCountWindow(unsigned span) {
+    SlidingMin<int> min(span);
+    SlidingMax<int> max(span);
+    SlidingAggregate<long> sum(span);
+    SlidingAggregate<std::string, Concat> concat(span);
+    std::vector<int> all;
+    std::mt19937 rng(span);
+    for (int i = 0; i < 5000; i++) {
+        if (rng() % 5 == 0) {
+            int batch[40];
+            long sums[40];
+            std::string strings[40];
+            size_t count = rng() % 40;
+            for (size_t j = 0; j < count; j++) {
+                batch[j] = rng() % 1000;
+                sums[j] = batch[j];
+                strings[j] = std::to_string(batch[j]) + ",";
+                all.push_back(batch[j]);
+            }
+            min.push_range(batch, count);
+            max.push_range(batch, count);
+            sum.push_range(sums, count);
+            concat.push_range(strings, count);
+        } else {
+            int value = rng() % 1000;
+            all.push_back(value);
+            min.push(value);
+            max.push(value);
+            sum.push(value);
+            concat.push(std::to_string(value) + ",");
+        }
+        if (all.empty()) {
+            continue;
+        }
+        size_t first = all.size() > span ? all.size() - span : 0;
+        long total = 0;
+        std::string joined;
+        for (size_t k = first; k < all.size(); k++) {
+            total += all[k];
+            joined += std::to_string(all[k]) + ",";
+        }
+        assert(min.front() == *std::min_element(all.begin() + first, all.end()));
+        assert(max.front() == *std::max_element(all.begin() + first, all.end()));
+        assert(sum.aggregate() == total && sum.size() == all.size() - first);
+        assert(concat.aggregate() == joined);
+    }
+}
+
+// A window of span time units over random non-decreasing stamps. The aggregate
+// also drops its oldest value now and then, so it gets a reference of its own.
+static void testTimeWindow(uint64_t span) {
+    SlidingMin<int> min(span);
+    SlidingMax<int> max(span);
+    SlidingAggregate<long> sum(span);
+    struct Stamped
+    {
+        int value;
+        uint64_t time;
+    };
+    std::vector<Stamped> window;
+    std::vector<Stamped> sumWindow;
+    auto expired = [span](uint64_t now) {
+        // Values stamped at or before now - span have expired
+        return [now, span](const Stamped& entry) { return entry.time + span <= now; };
+    };
+    std::mt19937 rng(7);
+    uint64_t time = 0;
+    for (int i = 0; i < 20000; i++) {
+        time += rng() % 4;
+        int value = rng() % 1000;
+        min.push(value, time);
+        max.push(value, time);
+        sum.push(value, time);
+        window.push_back(Stamped{ value, time });
+        sumWindow.push_back(Stamped{ value, time });
+        window.erase(std::remove_if(window.begin(), window.end(), expired(time)), window.end());
+        sumWindow.erase(std::remove_if(sumWindow.begin(), sumWindow.end(), expired(time)), sumWindow.end());
+        if (rng() % 10 == 0 && !sumWindow.empty()) {
+            sum.pop();
+            sumWindow.erase(sumWindow.begin());
+        }
+
+        int low = window.front().value;
+        int high = low;
+        for (const Stamped& entry : window) {
+            low = std::min(low, entry.value);
+            high = std::max(high, entry.value);
+        }
+        assert(min.front() == low && max.front() == high);
+        long total = 0;
+        for (const Stamped& entry : sumWindow) {
+            total += entry.value;
+        }
+        assert(sum.size() == sumWindow.size());
+        assert(sumWindow.empty() || sum.aggregate() == total);
+    }
+}
+
+int main() {
+    for (unsigned span : { 1u, 3u, 17u, 256u }) {
+        testCountWindow(span);
+    }
+    for (uint64_t span : { 1u, 5u, 100u }) {
+        testTimeWindow(span);
+    }
+    return 0;
+}
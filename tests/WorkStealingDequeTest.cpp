@@ -0,0 +1,110 @@
+/*
+ * This file is part of the DS Library (https://github.com/shreeviknesh/DS).
+ *
+ * MIT License
+ *
+ * Copyright (c) 2020 Shreeviknesh
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "WorkStealingDeque.h"
+#include <atomic>
+#include <cassert>
+#include <deque>
+#include <random>
+#include <thread>
+#include <vector>
+
+// On one thread the owner works the bottom and steal takes from the top
+static void testSequential() {
+    WorkStealingDeque<int> deque(4);
+    std::deque<int> reference;
+    std::mt19937 rng(1);
+    for (int i = 0; i < 200000; i++) {
+        int value;
+        switch (rng() % 4) {
+        case 0:
+        case 1:
+            deque.push(i);
+            reference.push_back(i);
+            break;
+        case 2:
+            assert(deque.pop(value) == !reference.empty());
+            if (!reference.empty()) {
+                assert(value == reference.back());
+                reference.pop_back();
+            }
+            break;
+        default:
+            assert(deque.steal(value) == !reference.empty());
+            if (!reference.empty()) {
+                assert(value == reference.front());
+                reference.pop_front();
+            }
+        }
+        assert(deque.size() == reference.size());
+    }
+}
+
+// The owner pushes and pops while thieves steal; every value is taken exactly once
+static void testConcurrent(int thieves) {
+    const int count = 200000;
+    WorkStealingDeque<int> deque(4);
+    std::vector<std::atomic<int>> taken(count);
+    for (auto& times : taken) {
+        times.store(0, std::memory_order_relaxed);
+    }
+    std::atomic<bool> done(false);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thieves; t++) {
+        threads.emplace_back([&deque, &taken, &done] {
+            int value;
+            while (!done.load(std::memory_order_acquire) || !deque.empty()) {
+                if (deque.steal(value)) {
+                    taken[value].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+    int value;
+    for (int i = 0; i < count; i++) {
+        deque.push(i);
+        if (i % 3 == 0 && deque.pop(value)) {
+            taken[value].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    while (deque.pop(value)) {
+        taken[value].fetch_add(1, std::memory_order_relaxed);
+    }
+    done.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int i = 0; i < count; i++) {
+        assert(taken[i].load(std::memory_order_relaxed) == 1);
+    }
+}
+
+int main() {
+    testSequential();
+    testConcurrent(1);
+    testConcurrent(3);
+    return 0;
+}